@@ -0,0 +1,47 @@
+// Stand-in for the Arduino Stream class of serstream: counts the calls into the port
+#ifndef BENCH_STREAM_H
+#define BENCH_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Stream{
+public:
+	Stream() : calls(0), bytes(0), checksum(0) { }
+	virtual ~Stream() { }
+
+	virtual size_t write(uint8_t c){
+		++calls;
+		++bytes;
+		checksum = checksum * 31 + c;
+		return 1;
+	}
+	virtual size_t write(const uint8_t * buffer, size_t n){
+		++calls;
+		bytes += n;
+		for(size_t i = 0; i < n; ++i){
+			checksum = checksum * 31 + buffer[i];
+		}
+		return n;
+	}
+	size_t print(char c){
+		return write((uint8_t)c);
+	}
+
+	virtual int available(){
+		return 0;
+	}
+	virtual int read(){
+		return -1;
+	}
+	virtual int peek(){
+		return -1;
+	}
+	void begin(long){  }
+
+	unsigned long int calls;
+	unsigned long int bytes;
+	unsigned long int checksum;
+};
+
+#endif
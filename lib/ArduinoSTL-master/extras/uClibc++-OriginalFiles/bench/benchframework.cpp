@@ -0,0 +1,99 @@
+#include "benchframework.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace BenchFramework{
+	unsigned long int comparisons;
+	unsigned long int allocations;
+	unsigned long int allocated_bytes;
+	unsigned long int largest_allocation;
+
+	namespace{
+		bool csv = false;
+		const char * current_title = "";
+		const char * current_count_name = "";
+		const char * current_time_name = "";
+	}
+
+	const char * patternName(int p){
+		switch(p){
+		case pattern_random:
+			return "random";
+		case pattern_sorted:
+			return "sorted";
+		case pattern_reversed:
+			return "reversed";
+		case pattern_organ_pipe:
+			return "organ_pipe";
+		case pattern_few_unique:
+			return "few_unique";
+		case no_pattern:
+			return "-";
+		}
+		return "?";
+	}
+
+	void fill(std::vector<int> & v, int p, unsigned long int n){
+		unsigned long int seed = 12345;
+		v.clear();
+		for(unsigned long int i = 0; i < n; ++i){
+			seed = seed * 1103515245UL + 12345UL;
+			int random = (int)((seed >> 16) & 0x7fff);
+			switch(p){
+			case pattern_random:
+				v.push_back(random);
+				break;
+			case pattern_sorted:
+				v.push_back(i);
+				break;
+			case pattern_reversed:
+				v.push_back(n - i);
+				break;
+			case pattern_organ_pipe:
+				v.push_back(i < n / 2 ? i : n - i);
+				break;
+			case pattern_few_unique:
+				v.push_back(random % 4);
+				break;
+			}
+		}
+	}
+
+	void header(const char * title, const char * count_name, const char * time_name){
+		const char * format = getenv("BENCH_FORMAT");
+		csv = format != 0 && strcmp(format, "csv") == 0;
+		current_title = title;
+		current_count_name = count_name;
+		current_time_name = time_name;
+		if(csv){
+			return;
+		}
+		printf("\n%s\n", title);
+		printf("%-16s %-11s %6s %12s %12s\n", "algorithm", "pattern", "n", count_name, time_name);
+	}
+
+	void report(const char * algorithm, int p, unsigned long int n,
+		unsigned long int comparisons_per_run, double time_per_run)
+	{
+		if(csv){
+			printf("%s,%s,%s,%lu,%s,%lu,%s,%.3f\n", current_title, algorithm, patternName(p), n,
+				current_count_name, comparisons_per_run, current_time_name, time_per_run);
+			return;
+		}
+		printf("%-16s %-11s %6lu %12lu %12.1f\n", algorithm, patternName(p), n,
+			comparisons_per_run, time_per_run);
+	}
+
+	unsigned long int runsFor(unsigned long int n){
+		unsigned long int runs = 16384 / n;
+		if(runs < 1){
+			runs = 1;
+		}
+		return runs;
+	}
+
+	double microsSince(clock_t start){
+		return (clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+	}
+
+}
@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+namespace BenchFramework{
+	extern unsigned long int comparisons;
+	extern unsigned long int allocations;
+	extern unsigned long int allocated_bytes;
+	extern unsigned long int largest_allocation;
+
+	// Allocator that counts the allocations of a container
+	template <class T> class counting_allocator : public std::allocator<T>{
+	public:
+		typedef typename std::allocator<T>::pointer pointer;
+		typedef typename std::allocator<T>::size_type size_type;
+		template <class U> struct rebind { typedef counting_allocator<U> other; };
+
+		counting_allocator() { }
+		template <class U> counting_allocator(const counting_allocator<U> &) { }
+
+		pointer allocate(size_type n, const void * hint = 0){
+			++allocations;
+			allocated_bytes += n * sizeof(T);
+			if(n * sizeof(T) > largest_allocation){
+				largest_allocation = n * sizeof(T);
+			}
+			return std::allocator<T>::allocate(n, hint);
+		}
+	};
+
+	template <class T, class U> bool operator==(const counting_allocator<T> &, const counting_allocator<U> &){
+		return true;
+	}
+	template <class T, class U> bool operator!=(const counting_allocator<T> &, const counting_allocator<U> &){
+		return false;
+	}
+
+	// Comparison that counts how often it has been called
+	template <class T> class counting_less{
+	public:
+		bool operator()(const T& a, const T& b) const {
+			++comparisons;
+			return a < b;
+		}
+	};
+
+	// Equality of hash tables that counts how often it has been called
+	template <class T> class counting_equal_to{
+	public:
+		bool operator()(const T& a, const T& b) const {
+			++comparisons;
+			return a == b;
+		}
+	};
+
+	// Input patterns
+	enum pattern{
+		pattern_random,
+		pattern_sorted,
+		pattern_reversed,
+		pattern_organ_pipe,
+		pattern_few_unique,
+		end_of_patterns
+	};
+	const int no_pattern = end_of_patterns;	// input does not matter
+
+	const char * patternName(int p);
+
+	// Reproducible on every host - does not depend on rand() of the C library
+	void fill(std::vector<int> & v, int p, unsigned long int n);
+
+	// count_name: what the count column counts, time_name: unit of the time
+	// column.  With BENCH_FORMAT=csv in the environment header() prints
+	// nothing and report() one line of bench,algorithm,pattern,n,count_name,
+	// count,time_name,time
+	void header(const char * title, const char * count_name = "comparisons",
+		const char * time_name = "micros");
+	void report(const char * algorithm, int p, unsigned long int n,
+		unsigned long int comparisons_per_run, double time_per_run);
+
+	// Runs of the same measurement, small sizes get repeated more often
+	unsigned long int runsFor(unsigned long int n);
+
+	double microsSince(clock_t start);
+}
@@ -0,0 +1,290 @@
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <serstream>
+#include "benchframework.h"
+
+using BenchFramework::counting_allocator;
+
+typedef std::vector<int, counting_allocator<int> > vectortype;
+typedef std::deque<int, counting_allocator<int> > dequetype;
+typedef std::list<int, counting_allocator<int> > listtype;
+// map of this library takes the allocator of the mapped type
+typedef std::map<int, int, std::less<int>, counting_allocator<int> > maptype;
+typedef std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+	counting_allocator<std::pair<const int, int> > > unorderedtype;
+typedef std::basic_string<char, std::char_traits<char>, counting_allocator<char> > stringtype;
+typedef std::vector<stringtype, counting_allocator<stringtype> > linestype;
+
+// The same operation on every element of a container of n elements, runs times
+void report(const char * name, int p, unsigned long int n, unsigned long int runs, clock_t start){
+	double nanos = BenchFramework::microsSince(start) * 1000 / (runs * n);
+	BenchFramework::report(name, p, n, BenchFramework::allocations / runs, nanos);
+	BenchFramework::allocations = 0;
+}
+
+// One of two results, the compiler can't construct it in place of the caller
+vectortype splitKeys(const std::vector<int> & keys, unsigned long int n){
+	vectortype even;
+	vectortype odd;
+	for(unsigned long int i = 0; i < n; ++i){
+		if(keys[i] % 2 == 0){
+			even.push_back(keys[i]);
+		}else{
+			odd.push_back(keys[i]);
+		}
+	}
+	if(even.size() > odd.size()){
+		return even;
+	}
+	return odd;
+}
+
+int main(){
+	const unsigned long int sizes[] = { 8, 32, 128, 512, 2048, 4096 };
+	const int random = BenchFramework::pattern_random;
+	const int none = BenchFramework::no_pattern;
+	std::vector<int> keys;
+	unsigned long int check = 0;
+	Stream port;
+	std::ohserialstream out(port);
+
+	BenchFramework::header("container benchmark - allocations per run", "allocations", "ns/element");
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+		unsigned long int n = sizes[s];
+		unsigned long int runs = BenchFramework::runsFor(n);
+		BenchFramework::fill(keys, random, n);
+		BenchFramework::allocations = 0;
+
+		// push_back
+		clock_t start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			vectortype v;
+			for(unsigned long int i = 0; i < n; ++i){
+				v.push_back(keys[i]);
+			}
+			check += v.back();
+		}
+		report("vector push_back", none, n, runs, start);
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			dequetype d;
+			for(unsigned long int i = 0; i < n; ++i){
+				d.push_back(keys[i]);
+			}
+			check += d.back();
+		}
+		report("deque push_back", none, n, runs, start);
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			listtype l;
+			for(unsigned long int i = 0; i < n; ++i){
+				l.push_back(keys[i]);
+			}
+			check += l.back();
+		}
+		report("list push_back", none, n, runs, start);
+
+		// insert of random keys
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			maptype m;
+			for(unsigned long int i = 0; i < n; ++i){
+				m[keys[i]] = keys[i];
+			}
+			check += m.size();
+		}
+		report("map insert", random, n, runs, start);
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			unorderedtype m;
+			for(unsigned long int i = 0; i < n; ++i){
+				m[keys[i]] = keys[i];
+			}
+			check += m.size();
+		}
+		report("unordered insert", random, n, runs, start);
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			vectortype v;
+			for(unsigned long int i = 0; i < n; ++i){
+				v.insert(std::lower_bound(v.begin(), v.end(), keys[i]), keys[i]);
+			}
+			check += v.size();
+		}
+		report("sorted vector", random, n, runs, start);
+
+		// find of every key, the containers are built before the clock starts
+		{
+			maptype m;
+			unorderedtype u;
+			vectortype v;
+			listtype l;
+			for(unsigned long int i = 0; i < n; ++i){
+				m[keys[i]] = keys[i];
+				u[keys[i]] = keys[i];
+				v.push_back(keys[i]);
+				l.push_back(keys[i]);
+			}
+			std::sort(v.begin(), v.end());
+			BenchFramework::allocations = 0;
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					check += m.find(keys[i])->second;
+				}
+			}
+			report("map find", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					check += u.find(keys[i])->second;
+				}
+			}
+			report("unordered find", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					check += *std::lower_bound(v.begin(), v.end(), keys[i]);
+				}
+			}
+			report("lower_bound", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					check += *std::find(l.begin(), l.end(), keys[i]);
+				}
+			}
+			report("list find", random, n, runs, start);
+		}
+
+		// sort, the copy to sort is made before the clock starts
+		{
+			double micros = 0;
+			for(unsigned long int r = 0; r < runs; ++r){
+				vectortype v(keys.begin(), keys.end());
+				start = clock();
+				std::sort(v.begin(), v.end());
+				micros += BenchFramework::microsSince(start);
+				check += v.front();
+			}
+			BenchFramework::report("vector sort", random, n, 0, micros * 1000 / (runs * n));
+
+			micros = 0;
+			for(unsigned long int r = 0; r < runs; ++r){
+				listtype l(keys.begin(), keys.end());
+				BenchFramework::allocations = 0;
+				start = clock();
+				l.sort();
+				micros += BenchFramework::microsSince(start);
+				check += l.front();
+			}
+			BenchFramework::report("list sort", random, n, BenchFramework::allocations,
+				micros * 1000 / (runs * n));
+			BenchFramework::allocations = 0;
+		}
+
+		// string append of a short piece, like a line of a log
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			stringtype line;
+			for(unsigned long int i = 0; i < n; ++i){
+				line.append("step ", 5);
+			}
+			check += line.size();
+		}
+		report("string append", none, n, runs, start);
+
+		// search of a word at the far end of a line of n characters, the start
+		// position changes with every run so that the search can't be hoisted
+		{
+			stringtype text;
+			for(unsigned long int i = 0; i < n; ++i){
+				text.push_back('a' + keys[i] % 26);
+			}
+			stringtype tail = text + "Nextion";
+			stringtype head = "Nextion" + text;
+			stringtype copy = tail;
+			BenchFramework::allocations = 0;
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				check += tail.find("Nextion", r & 1);
+			}
+			report("string find", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				check += head.rfind("Nextion", head.size() - (r & 1));
+			}
+			report("string rfind", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				check += head.find_last_of("NX", head.size() - (r & 1));
+			}
+			report("string last_of", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				check += tail.compare(r & 1, tail.size(), copy.data() + (r & 1), copy.size() - (r & 1));
+			}
+			report("string compare", random, n, runs, start);
+		}
+
+		// results returned by value and temporaries, moved instead of copied
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			vectortype v(splitKeys(keys, n));
+			check += v.size();
+		}
+		report("return vector", random, n, runs, start);
+
+		{
+			stringtype name("Cylinder of the punching station");
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					stringtype line = stringtype("step ") + name + ": " + char('0' + keys[i] % 10) + '\n';
+					check += line.size();
+				}
+			}
+			report("string a + b + c", random, n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				linestype lines;
+				for(unsigned long int i = 0; i < n; ++i){
+					lines.push_back(name);
+				}
+				check += lines.size();
+			}
+			report("vector<string>", none, n, runs, start);
+		}
+
+		// stream output of numbers into a serial port
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			for(unsigned long int i = 0; i < n; ++i){
+				out << keys[i] << ' ';
+			}
+			out.flush();
+		}
+		report("stream << int", random, n, runs, start);
+	}
+
+	return check == 0;
+}
@@ -0,0 +1,101 @@
+#include <deque>
+#include <vector>
+#include "benchframework.h"
+
+using BenchFramework::counting_allocator;
+
+typedef std::deque<int, counting_allocator<int> > dequetype;
+
+// The largest single allocation of the runs, that much contiguous heap the
+// deque needs at its peak
+void report(const char * name, unsigned long int n, unsigned long int runs, clock_t start){
+	double nanos = BenchFramework::microsSince(start) * 1000 / (runs * n);
+	BenchFramework::report(name, BenchFramework::no_pattern, n, BenchFramework::largest_allocation, nanos);
+	BenchFramework::largest_allocation = 0;
+}
+
+int main(){
+	const unsigned long int sizes[] = { 8, 32, 128, 512, 2048, 4096 };
+	std::vector<int> keys;
+	unsigned long int check = 0;
+
+	BenchFramework::header("deque benchmark - largest allocation", "bytes", "ns/element");
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+		unsigned long int n = sizes[s];
+		unsigned long int runs = BenchFramework::runsFor(n);
+		BenchFramework::fill(keys, BenchFramework::pattern_random, n);
+		BenchFramework::largest_allocation = 0;
+
+		clock_t start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			dequetype d;
+			for(unsigned long int i = 0; i < n; ++i){
+				d.push_back(keys[i]);
+			}
+			check += d.back();
+		}
+		report("push_back", n, runs, start);
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			dequetype d;
+			for(unsigned long int i = 0; i < n; ++i){
+				d.push_front(keys[i]);
+			}
+			check += d.front();
+		}
+		report("push_front", n, runs, start);
+
+		// Both ends, like a command queue with urgent commands in front
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			dequetype d;
+			for(unsigned long int i = 0; i < n; ++i){
+				if(keys[i] % 4 == 0){
+					d.push_front(keys[i]);
+				}else{
+					d.push_back(keys[i]);
+				}
+			}
+			check += d.size();
+		}
+		report("mixed push", n, runs, start);
+
+		// A queue that holds n elements, n are added and n taken out per run
+		{
+			dequetype d;
+			for(unsigned long int i = 0; i < n; ++i){
+				d.push_back(keys[i]);
+			}
+			BenchFramework::largest_allocation = 0;
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					d.push_back(keys[i]);
+					check += d.front();
+					d.pop_front();
+				}
+			}
+			report("queue", n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					check += d[keys[i] % n];
+				}
+			}
+			report("operator[]", n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(dequetype::iterator i = d.begin(); i != d.end(); ++i){
+					check += *i;
+				}
+			}
+			report("iterate", n, runs, start);
+		}
+	}
+
+	return check == 0;
+}
@@ -0,0 +1,95 @@
+#include <map>
+#include <list>
+#include <vector>
+#include "benchframework.h"
+
+using BenchFramework::counting_less;
+
+typedef std::map<int, int, counting_less<int> > maptype;
+
+#ifdef __UCLIBCXX_STL_FLAT_ASSOCIATIVE__
+const char * title = "Map benchmark (flat backing) - per run";
+#else
+const char * title = "Map benchmark (tree backing) - per run";
+#endif
+
+// Linear search in a sorted list, how map worked before the tree - for reference
+std::list<std::pair<int, int> >::iterator listFind(std::list<std::pair<int, int> > & l, int key){
+	counting_less<int> comp;
+	std::list<std::pair<int, int> >::iterator i = l.begin();
+	while(i != l.end() && comp(i->first, key)){
+		++i;
+	}
+	return i;
+}
+
+void report(const char * name, int p, unsigned long int n, unsigned long int runs, double micros){
+	BenchFramework::report(name, p, n, BenchFramework::comparisons / runs, micros / runs);
+	BenchFramework::comparisons = 0;
+}
+
+int main(){
+	const unsigned long int sizes[] = { 8, 32, 128, 512, 2048 };
+	const int patterns[] = { BenchFramework::pattern_random, BenchFramework::pattern_sorted };
+	std::vector<int> keys;
+
+	BenchFramework::header(title);
+
+	for(unsigned int p = 0; p < sizeof(patterns) / sizeof(patterns[0]); ++p){
+		for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+			unsigned long int n = sizes[s];
+			unsigned long int runs = BenchFramework::runsFor(n);
+			BenchFramework::fill(keys, patterns[p], n);
+
+			//n inserts, then n lookups of the same keys
+			double insert_micros = 0;
+			double find_micros = 0;
+			unsigned long int insert_comparisons = 0;
+			unsigned long int found = 0;
+			for(unsigned long int r = 0; r < runs; ++r){
+				maptype m;
+				BenchFramework::comparisons = 0;
+				clock_t start = clock();
+				for(unsigned long int i = 0; i < n; ++i){
+					m[keys[i]] = i;
+				}
+				insert_micros += BenchFramework::microsSince(start);
+				insert_comparisons += BenchFramework::comparisons;
+
+				start = clock();
+				for(unsigned long int i = 0; i < n; ++i){
+					found += m.find(keys[i]) != m.end();
+				}
+				find_micros += BenchFramework::microsSince(start);
+			}
+			if(found != n * runs){
+				printf("map lost keys\n");
+				return 1;
+			}
+			unsigned long int find_comparisons = BenchFramework::comparisons;
+			BenchFramework::comparisons = insert_comparisons;
+			report("map insert", patterns[p], n, runs, insert_micros);
+			BenchFramework::comparisons = find_comparisons * runs;
+			report("map find", patterns[p], n, runs, find_micros);
+
+			std::list<std::pair<int, int> > l;
+			maptype sorted_keys;
+			for(unsigned long int i = 0; i < n; ++i){
+				sorted_keys[keys[i]] = i;
+			}
+			for(maptype::iterator i = sorted_keys.begin(); i != sorted_keys.end(); ++i){
+				l.push_back(*i);
+			}
+			BenchFramework::comparisons = 0;
+			clock_t start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				for(unsigned long int i = 0; i < n; ++i){
+					found += listFind(l, keys[i]) != l.end();
+				}
+			}
+			report("list find (old)", patterns[p], n, runs, BenchFramework::microsSince(start));
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <ostream_helpers>
+#include "benchframework.h"
+#include <cstring>
+
+// The values a sketch prints: counters, forces and sensor readings
+long int integerValue(unsigned long int i){
+	return static_cast<long int>(i * 7919 % 200003) - 100000;
+}
+
+double floatValue(unsigned long int i){
+	return static_cast<double>(integerValue(i)) / 64;
+}
+
+int main(){
+	const unsigned long int n = 65536;
+	char buffer[std::__float_chars];
+	unsigned long int characters = 0;
+
+	BenchFramework::header("number formatting benchmark - per number", "characters");
+
+	clock_t start = clock();
+	for(unsigned long int i = 0; i < n; ++i){
+		characters += snprintf(buffer, sizeof(buffer), "%ld", integerValue(i));
+	}
+	BenchFramework::report("snprintf %ld", BenchFramework::no_pattern, n, characters / n,
+		BenchFramework::microsSince(start) / n);
+
+	characters = 0;
+	start = clock();
+	for(unsigned long int i = 0; i < n; ++i){
+		long int value = integerValue(i);
+		characters += std::__format_integer(buffer, static_cast<unsigned long int>(value), value < 0, std::ios_base::dec);
+	}
+	BenchFramework::report("helpers %ld", BenchFramework::no_pattern, n, characters / n,
+		BenchFramework::microsSince(start) / n);
+
+	characters = 0;
+	start = clock();
+	for(unsigned long int i = 0; i < n; ++i){
+		characters += snprintf(buffer, sizeof(buffer), "%#lx", integerValue(i));
+	}
+	BenchFramework::report("snprintf %#lx", BenchFramework::no_pattern, n, characters / n,
+		BenchFramework::microsSince(start) / n);
+
+	characters = 0;
+	start = clock();
+	for(unsigned long int i = 0; i < n; ++i){
+		characters += std::__format_integer(buffer, static_cast<unsigned long int>(integerValue(i)), false,
+			std::ios_base::hex | std::ios_base::showbase);
+	}
+	BenchFramework::report("helpers %#lx", BenchFramework::no_pattern, n, characters / n,
+		BenchFramework::microsSince(start) / n);
+
+	characters = 0;
+	start = clock();
+	for(unsigned long int i = 0; i < n; ++i){
+		characters += snprintf(buffer, sizeof(buffer), "%g", floatValue(i));
+	}
+	BenchFramework::report("snprintf %g", BenchFramework::no_pattern, n, characters / n,
+		BenchFramework::microsSince(start) / n);
+
+	characters = 0;
+	start = clock();
+	for(unsigned long int i = 0; i < n; ++i){
+		characters += std::__format_float(buffer, floatValue(i), 0, 6);
+	}
+	BenchFramework::report("helpers %g", BenchFramework::no_pattern, n, characters / n,
+		BenchFramework::microsSince(start) / n);
+
+	// Both have to print the same text
+	for(unsigned long int i = 0; i < n; ++i){
+		char expected[std::__float_chars];
+		snprintf(expected, sizeof(expected), "%g", floatValue(i));
+		buffer[std::__format_float(buffer, floatValue(i), 0, 6)] = 0;
+		if(strcmp(buffer, expected) != 0){
+			printf("__format_float printed %s instead of %s\n", buffer, expected);
+			return 1;
+		}
+	}
+	return 0;
+}
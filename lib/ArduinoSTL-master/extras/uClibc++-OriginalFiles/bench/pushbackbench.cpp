@@ -0,0 +1,73 @@
+#include <vector>
+#include <deque>
+#include <string>
+#include "benchframework.h"
+
+#if __UCLIBCXX_VECTOR_GROWTH__ == __UCLIBCXX_STL_GROWTH_GEOMETRIC__
+const char * title = "push_back benchmark (geometric growth) - per run";
+#else
+const char * title = "push_back benchmark (additive growth) - per run";
+#endif
+
+// Element that counts how often it gets copied
+class counted_int{
+public:
+	static unsigned long int copies;
+	counted_int(int i = 0) : value(i) { }
+	counted_int(const counted_int & c) : value(c.value) { ++copies; }
+	counted_int & operator=(const counted_int & c) { value = c.value; ++copies; return *this; }
+	int value;
+};
+
+unsigned long int counted_int::copies = 0;
+
+void report(const char * name, unsigned long int n, unsigned long int runs, double micros){
+	BenchFramework::report(name, BenchFramework::no_pattern, n, counted_int::copies / runs, micros / runs);
+	counted_int::copies = 0;
+}
+
+int main(){
+	const unsigned long int sizes[] = { 8, 32, 128, 512, 2048, 4096 };
+	unsigned long int check = 0;
+
+	BenchFramework::header(title, "copies");
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+		unsigned long int n = sizes[s];
+		unsigned long int runs = BenchFramework::runsFor(n);
+
+		counted_int::copies = 0;
+		clock_t start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			std::vector<counted_int> v;
+			for(unsigned long int i = 0; i < n; ++i){
+				v.push_back(counted_int(i));
+			}
+			check += v.back().value;
+		}
+		report("vector", n, runs, BenchFramework::microsSince(start));
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			std::deque<counted_int> d;
+			for(unsigned long int i = 0; i < n; ++i){
+				d.push_back(counted_int(i));
+			}
+			check += d.back().value;
+		}
+		report("deque", n, runs, BenchFramework::microsSince(start));
+
+		// A log line built character by character, copies are not counted
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			std::string line;
+			for(unsigned long int i = 0; i < n; ++i){
+				line.push_back('a' + i % 26);
+			}
+			check += line.size();
+		}
+		report("string", n, runs, BenchFramework::microsSince(start));
+	}
+
+	return check == 0;
+}
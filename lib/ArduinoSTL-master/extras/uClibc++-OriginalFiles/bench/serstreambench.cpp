@@ -0,0 +1,46 @@
+#include <serstream>
+#include "benchframework.h"
+
+#if __UCLIBCXX_SERIAL_BUFSIZE__ > 1
+const char * title = "serial stream benchmark (buffered) - per line";
+#else
+const char * title = "serial stream benchmark (unbuffered) - per line";
+#endif
+
+int main(){
+	const unsigned long int lines = 4096;
+	Stream port;
+	std::ohserialstream out(port);
+
+	BenchFramework::header(title, "port calls");
+
+	// A short debug line, ended with endl
+	clock_t start = clock();
+	for(unsigned long int i = 0; i < lines; ++i){
+		out << "step " << i << " force " << i * 3 << " N" << std::endl;
+	}
+	BenchFramework::report("debug line endl", BenchFramework::no_pattern, lines, port.calls / lines,
+		BenchFramework::microsSince(start) / lines);
+
+	// The same line ended with '\n', flushed at the end only
+	port.calls = 0;
+	start = clock();
+	for(unsigned long int i = 0; i < lines; ++i){
+		out << "step " << i << " force " << i * 3 << " N\n";
+	}
+	out.flush();
+	BenchFramework::report("debug line \\n", BenchFramework::no_pattern, lines, port.calls / lines,
+		BenchFramework::microsSince(start) / lines);
+
+	// Every character has to arrive, "\n" as "\r\n"
+	unsigned long int expected = 0;
+	for(unsigned long int i = 0; i < lines; ++i){
+		char line[40];
+		expected += snprintf(line, sizeof(line), "step %lu force %lu N\r\n", i, i * 3);
+	}
+	if(port.bytes != 2 * expected){
+		printf("serial stream lost characters\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <vector>
+#include <list>
+#include "benchframework.h"
+
+using BenchFramework::counting_less;
+
+typedef std::vector<int>::iterator iter;
+
+// The stable_sort of uClibc++ before introsort and merge sort - for reference
+void bubbleSort(iter first, iter last, counting_less<int> comp){
+	iter temp;
+	--last;
+	while(last - first > 0){
+		temp = last;
+		while(temp != first){
+			if( comp( *temp, *(temp-1) ) ){
+				std::iter_swap( temp-1, temp);
+			}
+			--temp;
+		}
+		++first;
+	}
+}
+
+void runSort(std::vector<int> & v){
+	std::sort(v.begin(), v.end(), counting_less<int>());
+}
+
+void runStableSort(std::vector<int> & v){
+	std::stable_sort(v.begin(), v.end(), counting_less<int>());
+}
+
+void runBubbleSort(std::vector<int> & v){
+	bubbleSort(v.begin(), v.end(), counting_less<int>());
+}
+
+// The time includes the copies into and out of the list
+void runListSort(std::vector<int> & v){
+	std::list<int> l(v.begin(), v.end());
+	l.sort(counting_less<int>());
+	std::copy(l.begin(), l.end(), v.begin());
+}
+
+// Ten percent smallest elements, e.g. for a trimmed mean
+void runPartialSort(std::vector<int> & v){
+	std::partial_sort(v.begin(), v.begin() + v.size() / 10, v.end(), counting_less<int>());
+}
+
+// Median
+void runNthElement(std::vector<int> & v){
+	std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end(), counting_less<int>());
+}
+
+bool isSorted(const std::vector<int> & v, unsigned long int length){
+	for(unsigned long int i = 1; i < length; ++i){
+		if(v[i] < v[i-1]){
+			return false;
+		}
+	}
+	return true;
+}
+
+struct Algorithm{
+	const char * name;
+	void (*run)(std::vector<int> & v);
+	unsigned long int max_n;	// the reference is too slow for large ranges
+};
+
+int main(){
+	const Algorithm algorithms[] = {
+		{ "sort", runSort, 4096 },
+		{ "stable_sort", runStableSort, 4096 },
+		{ "partial_sort", runPartialSort, 4096 },
+		{ "nth_element", runNthElement, 4096 },
+		{ "list::sort", runListSort, 4096 },
+		{ "bubble (old)", runBubbleSort, 1024 },
+	};
+	const unsigned long int sizes[] = { 16, 64, 256, 1024, 4096 };
+
+	std::vector<int> input;
+	std::vector<int> work;
+
+	BenchFramework::header("Sorting benchmark - per run");
+
+	for(unsigned int a = 0; a < sizeof(algorithms) / sizeof(algorithms[0]); ++a){
+		for(int p = 0; p < BenchFramework::end_of_patterns; ++p){
+			for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+				unsigned long int n = sizes[s];
+				if(n > algorithms[a].max_n){
+					continue;
+				}
+				BenchFramework::fill(input, p, n);
+				unsigned long int runs = BenchFramework::runsFor(n);
+
+				BenchFramework::comparisons = 0;
+				double micros = 0;
+				for(unsigned long int r = 0; r < runs; ++r){
+					work = input;
+					clock_t start = clock();
+					algorithms[a].run(work);
+					micros += BenchFramework::microsSince(start);
+				}
+
+				//partial_sort sorts the first tenth only, nth_element nothing
+				unsigned long int sorted_length = n;
+				if(algorithms[a].run == runPartialSort){
+					sorted_length = n / 10;
+				}else if(algorithms[a].run == runNthElement){
+					sorted_length = 0;
+				}
+				if(!isSorted(work, sorted_length)){
+					printf("%s did not sort the %s input of %lu\n", algorithms[a].name,
+						BenchFramework::patternName(p), n);
+					return 1;
+				}
+
+				BenchFramework::report(algorithms[a].name, p, n,
+					BenchFramework::comparisons / runs, micros / runs);
+			}
+		}
+	}
+
+	return 0;
+}
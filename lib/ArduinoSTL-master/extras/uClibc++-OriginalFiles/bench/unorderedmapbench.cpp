@@ -0,0 +1,71 @@
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "benchframework.h"
+
+using BenchFramework::counting_less;
+using BenchFramework::counting_equal_to;
+
+typedef std::map<int, int, counting_less<int> > maptype;
+typedef std::unordered_map<int, int, std::hash<int>, counting_equal_to<int> > hashtype;
+typedef std::static_unordered_map<int, int, 2048, std::hash<int>, counting_equal_to<int> > statictype;
+
+// n inserts, then n lookups of the same keys, into a fresh container in every run
+template <class Container> bool measure(const char * insert_name, const char * find_name,
+	const std::vector<int> & keys, int p, unsigned long int runs)
+{
+	unsigned long int n = keys.size();
+	double insert_micros = 0;
+	double find_micros = 0;
+	unsigned long int insert_comparisons = 0;
+	unsigned long int find_comparisons = 0;
+	unsigned long int found = 0;
+	for(unsigned long int r = 0; r < runs; ++r){
+		Container c;
+		BenchFramework::comparisons = 0;
+		clock_t start = clock();
+		for(unsigned long int i = 0; i < n; ++i){
+			c[keys[i]] = i;
+		}
+		insert_micros += BenchFramework::microsSince(start);
+		insert_comparisons += BenchFramework::comparisons;
+
+		BenchFramework::comparisons = 0;
+		start = clock();
+		for(unsigned long int i = 0; i < n; ++i){
+			found += c.find(keys[i]) != c.end();
+		}
+		find_micros += BenchFramework::microsSince(start);
+		find_comparisons += BenchFramework::comparisons;
+	}
+	BenchFramework::report(insert_name, p, n, insert_comparisons / runs, insert_micros / runs);
+	BenchFramework::report(find_name, p, n, find_comparisons / runs, find_micros / runs);
+	BenchFramework::comparisons = 0;
+	return found == n * runs;
+}
+
+int main(){
+	const unsigned long int sizes[] = { 8, 32, 128, 512, 2048 };
+	const int patterns[] = { BenchFramework::pattern_random, BenchFramework::pattern_sorted };
+	std::vector<int> keys;
+
+	BenchFramework::header("map against unordered_map - per run");
+
+	for(unsigned int p = 0; p < sizeof(patterns) / sizeof(patterns[0]); ++p){
+		for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+			unsigned long int n = sizes[s];
+			unsigned long int runs = BenchFramework::runsFor(n);
+			BenchFramework::fill(keys, patterns[p], n);
+
+			if(!measure<maptype>("map insert", "map find", keys, patterns[p], runs)
+				|| !measure<hashtype>("unordered insert", "unordered find", keys, patterns[p], runs)
+				|| !measure<statictype>("static insert", "static find", keys, patterns[p], runs))
+			{
+				printf("lost keys\n");
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include <new>
+#include <cstdlib>
+#include <vector>
+#include <valarray>
+#include "benchframework.h"
+
+#if __has_include(<static_valarray>)
+#include <static_valarray>
+#define BENCH_STATIC_VALARRAY 1
+#endif
+
+// valarray allocates with new[], this benchmark counts every allocation of
+// the program
+void * operator new(size_t size) throw(std::bad_alloc){
+	++BenchFramework::allocations;
+	void * p = malloc(size ? size : 1);
+	if(p == 0){
+		abort();
+	}
+	return p;
+}
+void * operator new[](size_t size) throw(std::bad_alloc){
+	return operator new(size);
+}
+void operator delete(void * p) throw(){
+	free(p);
+}
+void operator delete[](void * p) throw(){
+	free(p);
+}
+void operator delete(void * p, size_t) throw(){
+	free(p);
+}
+void operator delete[](void * p, size_t) throw(){
+	free(p);
+}
+
+// The same calculation on the n samples of a sensor, runs times
+void report(const char * name, unsigned long int n, unsigned long int runs, clock_t start){
+	double nanos = BenchFramework::microsSince(start) * 1000 / (runs * n);
+	BenchFramework::report(name, BenchFramework::no_pattern, n, BenchFramework::allocations / runs, nanos);
+	BenchFramework::allocations = 0;
+}
+
+int main(){
+	const unsigned long int sizes[] = { 8, 32, 128, 512, 2048 };
+	const float offset = 512.0f;
+	const float scale = 0.125f;
+	std::vector<int> keys;
+	double check = 0;
+
+	BenchFramework::header("valarray benchmark - allocations per run", "allocations", "ns/element");
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+		unsigned long int n = sizes[s];
+		unsigned long int runs = BenchFramework::runsFor(n);
+		BenchFramework::fill(keys, BenchFramework::pattern_random, n + 3);
+
+		// Raw readings of an analog input and the three following samples
+		std::valarray<float> raw(n);
+		std::valarray<float> x1(n);
+		std::valarray<float> x2(n);
+		std::valarray<float> x3(n);
+		for(unsigned long int i = 0; i < n; ++i){
+			raw[i] = keys[i] % 1024;
+			x1[i] = keys[i + 1] % 1024;
+			x2[i] = keys[i + 2] % 1024;
+			x3[i] = keys[i + 3] % 1024;
+		}
+		std::valarray<float> result(n);
+		BenchFramework::allocations = 0;
+
+		// Offset and scale into the result of the last run
+		clock_t start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			result = (raw - offset) * scale;
+			check += result[r % n];
+		}
+		report("(a - o) * s", n, runs, start);
+
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			for(unsigned long int i = 0; i < n; ++i){
+				result[i] = (raw[i] - offset) * scale;
+			}
+			check += result[r % n];
+		}
+		report("loop (a - o) * s", n, runs, start);
+
+		// Second order calibration curve
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			result = raw * raw * 0.0001f + raw * scale - offset;
+			check += result[r % n];
+		}
+		report("a * a * c + ...", n, runs, start);
+
+		// Moving average of four samples
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			result = (raw + x1 + x2 + x3) / 4.0f;
+			check += result[r % n];
+		}
+		report("average of 4", n, runs, start);
+
+		// Squared error against the previous sample, only the sum is kept
+		start = clock();
+		for(unsigned long int r = 0; r < runs; ++r){
+			check += ((raw - x1) * (raw - x1)).sum();
+		}
+		report("sum((a - b)^2)", n, runs, start);
+
+#ifdef BENCH_STATIC_VALARRAY
+		{
+			std::static_valarray<float, 2048> fixed(raw);
+			std::static_valarray<float, 2048> fixed_result(n);
+			BenchFramework::allocations = 0;
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				fixed_result = (fixed - offset) * scale;
+				check += fixed_result[r % n];
+			}
+			report("static (a - o)*s", n, runs, start);
+
+			start = clock();
+			for(unsigned long int r = 0; r < runs; ++r){
+				fixed_result = (fixed + x1 + x2 + x3) / 4.0f;
+				check += fixed_result[r % n];
+			}
+			report("static average", n, runs, start);
+		}
+#endif
+	}
+
+	return check == 0;
+}
@@ -419,6 +419,138 @@ bool testSort() {
 	return true;
 }
 
+bool testSortLarge(){
+	std::vector<int> a;
+
+	//Descending with many duplicates - the worst case of the old bubble sort
+	for(int j = 0; j < 500; ++j){
+		a.push_back( (500 - j) / 3 );
+	}
+
+	std::sort(a.begin(), a.end());
+
+	for(int j = 1; j < 500; ++j){
+		if(a[j] < a[j-1]){
+			printf("Key %i (%i) is smaller than key %i (%i)\n", j, a[j], j-1, a[j-1]);
+			return false;
+		}
+	}
+	if(a[0] != 0 || a[499] != 166){
+		printf("Range is %i to %i instead of 0 to 166\n", a[0], a[499]);
+		return false;
+	}
+
+	return true;
+}
+
+bool testSortReverse(){
+	std::vector<int> a;
+	unsigned int random = 1;
+	for(int j = 0; j < 300; ++j){
+		random = random * 1103515245 + 12345;
+		a.push_back( (random >> 8) % 100 );
+	}
+	std::vector<int>::reverse_iterator first = a.rbegin();
+	std::vector<int>::reverse_iterator last = a.rend();
+	if( !(first < last) || first >= last || last - first != 300 ){
+		printf("reverse_iterator is not ordered like its positions\n");
+		return false;
+	}
+
+	//Ascending from the back is descending from the front
+	std::sort(a.rbegin(), a.rend());
+	for(int j = 1; j < 300; ++j){
+		if(a[j] > a[j-1]){
+			printf("Key %i (%i) is larger than key %i (%i)\n", j, a[j], j-1, a[j-1]);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool testMakeHeapLarge(){
+	std::vector<int> a;
+	for(int j = 0; j < 100; ++j){
+		a.push_back( (j * 37) % 101 );
+	}
+	std::make_heap(a.begin(), a.end());
+	for(int j = 1; j < 100; ++j){
+		if(a[(j - 1) / 2] < a[j]){
+			printf("Key %i (%i) is larger than its parent (%i)\n", j, a[j], a[(j - 1) / 2]);
+			return false;
+		}
+	}
+	return a[0] == 100;
+}
+
+bool compareTens(const int &a, const int &b){
+	return a / 10 < b / 10;
+}
+
+bool testStableSort(){
+	std::vector<int> a;
+
+	//Equal keys (same tens) must keep their order (ascending ones)
+	for(int j = 0; j < 100; ++j){
+		a.push_back( ((j * 7) % 10) * 10 + j / 10 );
+	}
+
+	std::stable_sort(a.begin(), a.end(), compareTens);
+
+	for(int j = 0; j < 100; ++j){
+		if(a[j] != (j / 10) * 10 + j % 10){
+			printf("Key %i should be %i but is %i\n", j, (j / 10) * 10 + j % 10, a[j]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool testPartialSortCopy(){
+	int v[4] = {11, 12, 12, 20};
+	int b[10] = {12, 32, 11, 93, 12, 23, 38, 53, 72, 20};
+	std::vector<int> a(4);
+
+	std::vector<int>::iterator i = std::partial_sort_copy(b, b + 10, a.begin(), a.end());
+
+	if(i != a.end()){
+		printf("Not all 4 elements copied\n");
+		return false;
+	}
+	for(int j = 0; j < 4; ++j){
+		if(v[j] != a[j]){
+			printf("Key %i should be %i but is %i\n", j, v[j], a[j]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool testNthElement(){
+	std::vector<int> a;
+
+	for(int j = 0; j < 200; ++j){
+		a.push_back( (j * 37) % 200 );
+	}
+
+	std::nth_element(a.begin(), a.begin() + 50, a.end());
+
+	if(a[50] != 50){
+		printf("Element 50 should be 50 but is %i\n", a[50]);
+		return false;
+	}
+	for(int j = 0; j < 200; ++j){
+		if( (j < 50 && a[j] > 50) || (j > 50 && a[j] < 50) ){
+			printf("Key %i (%i) is on the wrong side\n", j, a[j]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool testInplaceMerge(){
 	std::vector<int> a;
 	std::vector<int>::iterator i;
@@ -603,6 +735,12 @@ int main(){
         TestFramework::AssertReturns<bool>(testSortHeap, true);
         TestFramework::AssertReturns<bool>(testPartialSort, true);
         TestFramework::AssertReturns<bool>(testSort, true);
+        TestFramework::AssertReturns<bool>(testSortLarge, true);
+        TestFramework::AssertReturns<bool>(testSortReverse, true);
+        TestFramework::AssertReturns<bool>(testMakeHeapLarge, true);
+        TestFramework::AssertReturns<bool>(testStableSort, true);
+        TestFramework::AssertReturns<bool>(testPartialSortCopy, true);
+        TestFramework::AssertReturns<bool>(testNthElement, true);
         TestFramework::AssertReturns<bool>(testInplaceMerge, true);
         TestFramework::AssertReturns<bool>(testNextPermutation, true);
         TestFramework::AssertReturns<bool>(testPrevPermutation, true);
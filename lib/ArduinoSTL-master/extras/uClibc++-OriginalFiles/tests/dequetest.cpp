@@ -86,6 +86,84 @@ bool canCompareConstNonConstIter() {
 	return true;
 }
 
+//Elements must not move when the deque grows at either end
+bool elementsStayInPlace(){
+	std::deque<long> d;
+	d.push_back(0);
+	const long * first = &d[0];
+	for(long i = 1; i <= 300; ++i){
+		d.push_back(i);
+		d.push_front(-i);
+	}
+	const long * last = &d.back();
+	for(long i = 301; i <= 600; ++i){
+		d.push_back(i);
+		d.push_front(-i);
+	}
+	if(d.size() != 1201 || &d[600] != first || &d[900] != last){
+		return false;
+	}
+	for(long i = 0; i < 1201; ++i){
+		if(d[i] != i - 600 || *(d.begin() + i) != i - 600){
+			return false;
+		}
+	}
+	return true;
+}
+
+//A queue that goes through many blocks keeps its order
+bool queueKeepsOrder(){
+	std::deque<int> d;
+	int next = 0;
+	int expected = 0;
+	for(int round = 0; round < 200; ++round){
+		for(int i = 0; i < 7; ++i){
+			d.push_back(next++);
+		}
+		for(int i = 0; i < 5; ++i){
+			if(d.front() != expected++){
+				return false;
+			}
+			d.pop_front();
+		}
+	}
+	while(!d.empty()){
+		if(d.front() != expected++){
+			return false;
+		}
+		d.pop_front();
+	}
+	//Empty again, both ends still work
+	d.push_front(2);
+	d.push_back(3);
+	d.push_front(1);
+	return expected == next && d.size() == 3 && d[0] == 1 && d[1] == 2 && d[2] == 3;
+}
+
+//Insert and erase in the middle shift elements across block boundaries
+bool insertEraseAcrossBlocks(){
+	std::deque<int> d;
+	for(int i = 0; i < 100; ++i){
+		d.push_back(i * 2);
+	}
+	for(int i = 0; i < 100; ++i){
+		d.insert(d.begin() + (i * 2 + 1), i * 2 + 1);
+	}
+	for(int i = 0; i < 200; ++i){
+		if(d[i] != i){
+			return false;
+		}
+	}
+	d.erase(d.begin() + 10, d.begin() + 150);
+	d.erase(d.begin() + 3);
+	if(d.size() != 59 || d[2] != 2 || d[3] != 4 || d[9] != 150 || d.back() != 199){
+		return false;
+	}
+	d.resize(3);
+	d.resize(5, 7);
+	return d.size() == 5 && d[2] == 2 && d[4] == 7;
+}
+
 int main(){
 	std::deque<double> test;
 	std::deque<double>::iterator i,j;
@@ -248,6 +326,9 @@ int main(){
 	TestFramework::AssertReturns<bool>(canSwapUnary, true);
 	TestFramework::AssertReturns<bool>(canSwapBinary, true);
 	TestFramework::AssertReturns<bool>(canCompareConstNonConstIter, true);
+	TestFramework::AssertReturns<bool>(elementsStayInPlace, true);
+	TestFramework::AssertReturns<bool>(queueKeepsOrder, true);
+	TestFramework::AssertReturns<bool>(insertEraseAcrossBlocks, true);
 
 	TestFramework::results();
 
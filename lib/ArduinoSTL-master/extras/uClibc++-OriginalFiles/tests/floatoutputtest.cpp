@@ -0,0 +1,53 @@
+#include <iostream>
+#include <iomanip>
+
+//At most 9 significant digits are printed, a higher precision() prints no
+//more digits after the point and zeros in the integer part
+void printFixed(){
+	std::cout << "Fixed:" << std::endl;
+	std::cout << std::fixed << std::setprecision(8);
+	std::cout << 82649537.220687747 << std::endl;
+	std::cout << 5614.2954589848468 << std::endl;
+	std::cout << 3.14159265358979 << std::endl;
+	std::cout << 0.125 << std::endl;
+	std::cout << 1234567895.0 << std::endl;
+	std::cout << 999999999.7 << std::endl;
+	std::cout << 1e20 << std::endl;
+	std::cout << std::setprecision(3);
+	std::cout << 0.00050000000000000001 << std::endl;
+	std::cout << 0.0005 << std::endl;
+	std::cout << 0.0625 << std::endl;
+	std::cout << 2.0005 << std::endl;
+	std::cout << std::setprecision(0);
+	std::cout << 0.5 << " " << 1.5 << " " << 2.5 << std::endl;
+}
+
+void printScientific(){
+	std::cout << "Scientific:" << std::endl;
+	std::cout << std::scientific << std::setprecision(3);
+	std::cout << 829.65000000000009 << std::endl;
+	std::cout << 829.65 << std::endl;
+	std::cout << 1e-30 << std::endl;
+	std::cout << std::setprecision(12);
+	std::cout << 82649537.220687747 << std::endl;
+}
+
+void printGeneral(){
+	std::cout << "General:" << std::endl;
+	std::cout.unsetf(std::ios_base::floatfield);
+	std::cout << std::setprecision(6);
+	std::cout << 82649537.220687747 << std::endl;
+	std::cout << 0.0001234565 << std::endl;
+	std::cout << 100000.5 << std::endl;
+	std::cout << std::setprecision(12);
+	std::cout << 5614.2954589848468 << std::endl;
+	std::cout << 0.1 << std::endl;
+}
+
+int main(){
+	std::cout << "Starting float output test" << std::endl;
+	printFixed();
+	printScientific();
+	printGeneral();
+	return 0;
+}
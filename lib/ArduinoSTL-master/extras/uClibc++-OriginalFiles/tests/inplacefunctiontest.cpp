@@ -0,0 +1,138 @@
+#include <functional>
+#include <stdexcept>
+#include <iostream>
+#include "testframework.h"
+
+int counter = 0;
+
+void increment(){
+	++counter;
+}
+
+int twice(int x){
+	return 2 * x;
+}
+
+class Motor{
+public:
+	Motor() : running(false), speed(0) {  }
+	void start(){
+		running = true;
+	}
+	void set_speed(int s){
+		speed = s;
+	}
+	bool running;
+	int speed;
+};
+
+//Counts its copies and destructions
+class Tracked{
+public:
+	Tracked() {  ++alive;  }
+	Tracked(const Tracked &) {  ++alive;  ++copies;  }
+	~Tracked() {  --alive;  }
+	int operator()(int x) const{
+		return x + 1;
+	}
+	static int alive;
+	static int copies;
+};
+int Tracked::alive = 0;
+int Tracked::copies = 0;
+
+bool callsFunctionPointers(){
+	counter = 0;
+	std::inplace_function<void()> f(increment);
+	std::inplace_function<int(int)> g = twice;
+	f();
+	f();
+	return counter == 2 && g(21) == 42 && f && g;
+}
+
+bool bindsMemberFunctions(){
+	Motor motor;
+	std::inplace_function<void()> start = [&motor]{ motor.start(); };
+	std::inplace_function<void(int)> speed = [&motor](int s){ motor.set_speed(s); };
+	start();
+	speed(120);
+	return motor.running && motor.speed == 120;
+}
+
+bool bindsParameters(){
+	int value = 0;
+	int * target = &value;
+	std::inplace_function<void(), 2 * sizeof(void *)> add_five = [target]{ *target += 5; };
+	add_five();
+	add_five();
+	return value == 10;
+}
+
+bool copiesAndMoves(){
+	int calls = 0;
+	int * target = &calls;
+	std::inplace_function<int(int)> a = [target](int x){ ++*target; return x * 3; };
+	std::inplace_function<int(int)> b(a);
+	std::inplace_function<int(int)> c(std::move(a));
+	std::inplace_function<int(int)> d;
+	d = b;
+	return !a && b(1) == 3 && c(2) == 6 && d(3) == 9 && calls == 3;
+}
+
+bool destroysTheCallable(){
+	Tracked::alive = 0;
+	Tracked::copies = 0;
+	{
+		std::inplace_function<int(int)> f = Tracked();
+		std::inplace_function<int(int)> g(f);
+		if(Tracked::alive != 2 || f(1) != 2 || g(2) != 3){
+			return false;
+		}
+		g = twice;
+		if(Tracked::alive != 1 || g(2) != 4){
+			return false;
+		}
+		g.swap(f);
+		if(g(1) != 2 || f(1) != 2 * 1){
+			return false;
+		}
+	}
+	return Tracked::alive == 0;
+}
+
+bool emptyFunctions(){
+	void (*none)() = 0;
+	std::inplace_function<void()> a;
+	std::inplace_function<void()> b(none);
+	bool thrown = false;
+	try{
+		a();
+	}catch(std::invalid_argument & e){
+		thrown = true;
+	}
+	return !a && !b && thrown;
+}
+
+bool fitsIntoItsCapacity(){
+	std::inplace_function<void()> f;
+	return f.capacity() == 2 * sizeof(void *)
+		&& sizeof(f) <= sizeof(void *) + 2 * sizeof(void *);
+}
+
+int main(){
+	std::cout << "Beginning inplace_function test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(callsFunctionPointers, true);
+	TestFramework::AssertReturns<bool>(bindsMemberFunctions, true);
+	TestFramework::AssertReturns<bool>(bindsParameters, true);
+	TestFramework::AssertReturns<bool>(copiesAndMoves, true);
+	TestFramework::AssertReturns<bool>(destroysTheCallable, true);
+	TestFramework::AssertReturns<bool>(emptyFunctions, true);
+	TestFramework::AssertReturns<bool>(fitsIntoItsCapacity, true);
+
+	TestFramework::results();
+
+	return 0;
+}
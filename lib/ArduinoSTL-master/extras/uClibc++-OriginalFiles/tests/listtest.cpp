@@ -18,6 +18,10 @@ public:
 };
 
 
+bool firstLess(const std::pair<int, char> & a, const std::pair<int, char> & b){
+	return a.first < b.first;
+}
+
 int main(){
 	std::string test;
 	std::list<double>temp(5, 12.0);
@@ -498,6 +502,53 @@ int main(){
 		}
 	}
 
+	std::cout << "\nTesting stable sort\n";
+	std::list<std::pair<int, char> > pairs;
+	const char letters[] = "dacbfe";
+	for(int j = 0; j < 12; ++j){
+		pairs.push_back(std::pair<int, char>(letters[j % 6] - 'a', 'A' + j));
+	}
+	pairs.sort(firstLess);
+	std::cout << "The following two lines should be identical:\n";
+	std::cout << "0B 0H 1D 1J 2C 2I 3A 3G 4F 4L 5E 5K \n";
+	for(std::list<std::pair<int, char> >::iterator j = pairs.begin(); j != pairs.end(); ++j){
+		std::cout << j->first << j->second << " ";
+	}
+	std::cout << std::endl;
+	pairs.reverse();
+	std::cout << "Reversed, first and last: " << pairs.front().first << pairs.front().second
+		<< " " << pairs.back().first << pairs.back().second << std::endl;
+
+	list_int_1.clear();
+	for(int j = 0; j < 1000; ++j){
+		list_int_1.push_back((j * 7919) % 1009);
+	}
+	list_int_1.sort();
+	bool sorted = true;
+	int previous = -1;
+	for(list_iter_1 = list_int_1.begin(); list_iter_1 != list_int_1.end(); ++list_iter_1){
+		if(*list_iter_1 < previous){
+			sorted = false;
+		}
+		previous = *list_iter_1;
+	}
+	std::cout << "1000 elements sorted: " << sorted << ", size: " << list_int_1.size() << std::endl;
+	list_iter_1 = list_int_1.end();
+	--list_iter_1;
+	std::cout << "Last element reached backwards: " << *list_iter_1 << std::endl;
+
+	std::cout << "\nTesting swap\n";
+	list_int_2.clear();
+	list_int_2.push_back(5);
+	list_int_1.swap(list_int_2);
+	std::cout << "Sizes after swap: " << list_int_1.size() << " " << list_int_2.size() << std::endl;
+	std::cout << "Front and back: " << list_int_1.front() << " " << list_int_1.back() << std::endl;
+	std::list<int> empty_list;
+	empty_list.swap(list_int_1);
+	list_int_1.push_back(6);
+	std::cout << "Swapped with an empty list: " << empty_list.size() << " " << list_int_1.size()
+		<< " " << *empty_list.begin() << " " << *(--empty_list.end()) << " " << list_int_1.front() << std::endl;
+
 
 	return 0;
 }
@@ -1,4 +1,6 @@
 #include <map>
+#include <set>
+#include <iterator>
 #include <iostream>
 #include "testframework.h"
 
@@ -139,6 +141,117 @@ bool canSubscriptWithoutExtraObjectCreation() {
 }
 
 
+bool canFindInLargeMap(){
+	std::map<int, int> a;
+
+	//Scrambled order, the backing has to keep it sorted
+	for(int i = 0; i < 500; ++i){
+		a[(i * 263) % 500] = i;
+	}
+	if(a.size() != 500){
+		return false;
+	}
+
+	int expected = 0;
+	for(std::map<int, int>::iterator i = a.begin(); i != a.end(); ++i, ++expected){
+		if(i->first != expected){
+			return false;
+		}
+	}
+	for(int i = 0; i < 500; ++i){
+		std::map<int, int>::iterator j = a.find((i * 263) % 500);
+		if(j == a.end() || j->second != i){
+			return false;
+		}
+	}
+	if(a.find(500) != a.end() || a.find(-1) != a.end()){
+		return false;
+	}
+	if(a.lower_bound(250)->first != 250 || a.upper_bound(250)->first != 251){
+		return false;
+	}
+
+	return true;
+}
+
+bool canEraseRange(){
+	std::map<int, int> a;
+
+	for(int i = 0; i < 100; ++i){
+		a[i] = i;
+	}
+
+	a.erase(a.lower_bound(10), a.lower_bound(90));
+	if(a.size() != 20){
+		return false;
+	}
+	if(a.erase(5) != 1 || a.erase(50) != 0){
+		return false;
+	}
+
+	int expected[19] = {0, 1, 2, 3, 4, 6, 7, 8, 9, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99};
+	std::map<int, int>::reverse_iterator r = a.rbegin();
+	for(int i = 18; i >= 0; --i, ++r){
+		if(r == a.rend() || r->first != expected[i]){
+			return false;
+		}
+	}
+
+	return r == a.rend();
+}
+
+bool canInsertWithHint(){
+	std::map<int, int> a;
+	std::map<int, int>::iterator i;
+
+	//Correct hints
+	for(int j = 0; j < 10; ++j){
+		i = a.insert(a.end(), std::make_pair(j * 2, j));
+		if(i->first != j * 2){
+			return false;
+		}
+	}
+	i = a.insert(a.find(4), std::make_pair(3, 0));
+	if(i->first != 3){
+		return false;
+	}
+
+	//Wrong hint and existing key
+	i = a.insert(a.begin(), std::make_pair(13, 0));
+	if(i->first != 13){
+		return false;
+	}
+	i = a.insert(a.end(), std::make_pair(4, 99));
+	if(i->first != 4 || i->second != 2 || a.size() != 12){
+		return false;
+	}
+
+	int previous = -1;
+	for(i = a.begin(); i != a.end(); ++i){
+		if(i->first <= previous){
+			return false;
+		}
+		previous = i->first;
+	}
+
+	return true;
+}
+
+bool canMeasureEmptyTrees(){
+	std::set<int> s;
+	std::map<int, int> m;
+	if(std::distance(s.begin(), s.end()) != 0 || std::distance(m.begin(), m.end()) != 0){
+		return false;
+	}
+	s.insert(1);
+	m[1] = 1;
+	m.erase(1);
+	s.erase(1);
+	return std::distance(s.begin(), s.end()) == 0 && std::distance(m.begin(), m.end()) == 0
+		&& s.begin() == s.end() && m.begin() == m.end();
+}
+
+
 int main(){
 	std::map<std::string, double> test;
 	std::map<std::string, double>::iterator i, j;
@@ -342,6 +455,10 @@ int main(){
 	TestFramework::AssertReturns<bool>(canCompareConstNonConstIter, true);
 	TestFramework::AssertReturns<bool>(canSwapCorrectly, true);
 	TestFramework::AssertReturns<bool>(canSubscriptWithoutExtraObjectCreation, true);
+	TestFramework::AssertReturns<bool>(canFindInLargeMap, true);
+	TestFramework::AssertReturns<bool>(canEraseRange, true);
+	TestFramework::AssertReturns<bool>(canInsertWithHint, true);
+	TestFramework::AssertReturns<bool>(canMeasureEmptyTrees, true);
 
 	TestFramework::results();
 
@@ -0,0 +1,261 @@
+#include <vector>
+#include <string>
+#include <list>
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <algorithm>
+#include <iostream>
+#include "testframework.h"
+
+//Counts how often it gets copied and how often moved
+class tracked{
+public:
+	static int copies;
+	static int moves;
+	static int alive;
+	tracked(int i = 0) : num(i) { ++alive; }
+	tracked(int i, int j) : num(i * 10 + j) { ++alive; }
+	tracked(const tracked & t) : num(t.num) { ++alive; ++copies; }
+	tracked(tracked && t) : num(t.num) { t.num = -1; ++alive; ++moves; }
+	~tracked() { --alive; }
+	tracked & operator=(const tracked & t) { num = t.num; ++copies; return *this; }
+	tracked & operator=(tracked && t) { num = t.num; t.num = -1; ++moves; return *this; }
+	bool operator<(const tracked & t) const { return num < t.num; }
+	static void reset() { copies = 0; moves = 0; }
+	int num;
+};
+
+int tracked::copies = 0;
+int tracked::moves = 0;
+int tracked::alive = 0;
+
+std::vector<int> makeVector(int n){
+	std::vector<int> even, odd;
+	for(int i = 0; i < n; ++i){
+		even.push_back(2 * i);
+		odd.push_back(2 * i + 1);
+	}
+	//Two candidates, no return value optimization
+	if(n % 2 == 0){
+		return even;
+	}
+	return odd;
+}
+
+std::string makeLine(const char * name, int step){
+	std::string line = name;
+	return line + ": step " + char('0' + step) + " of the cycle";
+}
+
+bool vectorMoveTakesArray(){
+	std::vector<int> v = makeVector(20);
+	const int * p = &v[0];
+	std::vector<int> w(std::move(v));
+	std::vector<int> x;
+	x = std::move(w);
+	return &x[0] == p && x.size() == 20 && x[19] == 38 && v.empty() && w.empty();
+}
+
+bool movedFromVectorIsUsable(){
+	std::vector<int> v(5, 1);
+	std::vector<int> w(std::move(v));
+	v.push_back(7);
+	v.push_back(8);
+	return v.size() == 2 && v[1] == 8 && w.size() == 5;
+}
+
+bool vectorGrowthMoves(){
+	std::vector<tracked> v;
+	tracked::reset();
+	for(int i = 0; i < 100; ++i){
+		v.push_back(tracked(i));
+	}
+	return tracked::copies == 0 && v[99].num == 99 && v[0].num == 0;
+}
+
+bool vectorEmplace(){
+	std::vector<tracked> v;
+	tracked::reset();
+	v.emplace_back(1, 2);
+	v.emplace_back(3);
+	v.emplace(v.begin() + 1, 5, 6);
+	v.emplace(v.begin(), 7, 8);
+	v.emplace(v.end(), 9);
+	return tracked::copies == 0 && v.size() == 5 && v[0].num == 78 && v[1].num == 12
+		&& v[2].num == 56 && v[3].num == 3 && v[4].num == 9;
+}
+
+bool vectorPushBackOwnElement(){
+	std::vector<std::string> v;
+	v.push_back("A string longer than the local buffer");
+	while(v.size() < v.capacity()){
+		v.push_back(v[0]);
+	}
+	v.push_back(v[0]);
+	v.emplace_back(v[0]);
+	v.insert(v.begin(), v.back());
+	for(size_t i = 0; i < v.size(); ++i){
+		if(v[i] != "A string longer than the local buffer"){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool vectorEraseMoves(){
+	std::vector<tracked> v;
+	for(int i = 0; i < 10; ++i){
+		v.emplace_back(i);
+	}
+	tracked::reset();
+	v.erase(v.begin());
+	v.erase(v.begin(), v.begin() + 2);
+	return tracked::copies == 0 && v.size() == 7 && v[0].num == 3;
+}
+
+bool stringMoveTakesBuffer(){
+	std::string a = "A string longer than the local buffer";
+	const char * p = a.data();
+	std::string b(std::move(a));
+	std::string c = "short";
+	c = std::move(b);
+	return c.data() == p && c == "A string longer than the local buffer" && a.empty() && b.empty();
+}
+
+bool stringMoveOfLocal(){
+	std::string a = "PULSEN";
+	std::string b = "A string longer than the local buffer";
+	b = std::move(a);
+	std::string c(std::move(b));
+	a = "again";
+	return c == "PULSEN" && b.empty() && a == "again";
+}
+
+bool stringConcatenation(){
+	std::string a = makeLine("Cylinder", 3);
+	std::string b = std::string("a") + "b" + 'c' + std::string("d");
+	return a == "Cylinder: step 3 of the cycle" && b == "abcd";
+}
+
+bool swapMoves(){
+	tracked a(1);
+	tracked b(2);
+	tracked::reset();
+	std::swap(a, b);
+	std::vector<tracked> v;
+	v.emplace_back(3);
+	v.emplace_back(1);
+	v.emplace_back(2);
+	std::sort(v.begin(), v.end());
+	return tracked::copies == 0 && a.num == 2 && b.num == 1 && v[0].num == 1 && v[2].num == 3;
+}
+
+bool listMoveAndEmplace(){
+	std::list<tracked> l;
+	tracked::reset();
+	l.emplace_back(1);
+	l.emplace_front(0);
+	l.push_back(tracked(3));
+	std::list<tracked>::iterator i = l.begin();
+	++i;
+	++i;
+	l.emplace(i, 2);
+	if(tracked::copies != 0){
+		return false;
+	}
+	std::list<tracked> m(std::move(l));
+	std::list<tracked> n;
+	n.push_back(tracked(9));
+	n = std::move(m);
+	l.push_back(tracked(5));
+	int expected = 0;
+	for(i = n.begin(); i != n.end(); ++i){
+		if(i->num != expected++){
+			return false;
+		}
+	}
+	return tracked::copies == 0 && n.size() == 4 && expected == 4 && l.size() == 1 && l.front().num == 5;
+}
+
+bool dequeMoveAndEmplace(){
+	std::deque<tracked> d;
+	tracked::reset();
+	for(int i = 0; i < 20; ++i){
+		d.emplace_back(i + 1);
+	}
+	d.emplace_front(0);
+	d.emplace(d.begin() + 15, 99);
+	d.emplace(d.begin() + 3, 98);
+	d.insert(d.begin() + 1, tracked(97));
+	d.erase(d.begin() + 1);
+	std::deque<tracked> e(std::move(d));
+	d.push_back(tracked(5));
+	return tracked::copies == 0 && e.size() == 23 && e[0].num == 0 && e[3].num == 98
+		&& e[4].num == 3 && e[16].num == 99 && e[22].num == 20 && d.size() == 1;
+}
+
+bool mapMoveTakesTree(){
+	std::map<int, std::string> m;
+	m[1] = "one";
+	m[2] = "two";
+	const std::string * p = &m[2];
+	std::map<int, std::string> n(std::move(m));
+	std::map<int, std::string> o;
+	o[3] = "three";
+	o = std::move(n);
+	std::set<int> s;
+	s.insert(4);
+	std::set<int> t(std::move(s));
+	return &o[2] == p && o.size() == 2 && o[1] == "one" && m.empty() && n.empty()
+		&& t.size() == 1 && s.empty();
+}
+
+bool destroysEveryElement(){
+	tracked::alive = 0;
+	{
+		std::vector<tracked> v;
+		std::list<tracked> l;
+		std::deque<tracked> d;
+		for(int i = 0; i < 30; ++i){
+			v.emplace_back(i);
+			l.emplace_back(i);
+			d.emplace_front(i);
+		}
+		v.emplace(v.begin() + 3, 7);
+		std::vector<tracked> w(std::move(v));
+		std::list<tracked> m(std::move(l));
+		std::deque<tracked> e(std::move(d));
+		v = std::move(w);
+		if(tracked::alive != 91){
+			return false;
+		}
+	}
+	return tracked::alive == 0;
+}
+
+int main(){
+	std::cout << "Beginning move test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(vectorMoveTakesArray, true);
+	TestFramework::AssertReturns<bool>(movedFromVectorIsUsable, true);
+	TestFramework::AssertReturns<bool>(vectorGrowthMoves, true);
+	TestFramework::AssertReturns<bool>(vectorEmplace, true);
+	TestFramework::AssertReturns<bool>(vectorPushBackOwnElement, true);
+	TestFramework::AssertReturns<bool>(vectorEraseMoves, true);
+	TestFramework::AssertReturns<bool>(stringMoveTakesBuffer, true);
+	TestFramework::AssertReturns<bool>(stringMoveOfLocal, true);
+	TestFramework::AssertReturns<bool>(stringConcatenation, true);
+	TestFramework::AssertReturns<bool>(swapMoves, true);
+	TestFramework::AssertReturns<bool>(listMoveAndEmplace, true);
+	TestFramework::AssertReturns<bool>(dequeMoveAndEmplace, true);
+	TestFramework::AssertReturns<bool>(mapMoveTakesTree, true);
+	TestFramework::AssertReturns<bool>(destroysEveryElement, true);
+
+	TestFramework::results();
+
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include <pool_allocator>
+#include <list>
+#include <map>
+#include <set>
+#include <iostream>
+#include "testframework.h"
+
+bool reusesFreedBlocks(){
+	std::pool_allocator<long, 4> a;
+	long * p[4];
+	for(int i = 0; i < 4; ++i){
+		p[i] = a.allocate(1);
+		a.construct(p[i], i);
+	}
+	if(std::pool_allocator<long, 4>::in_use() != 4){
+		return false;
+	}
+	a.deallocate(p[1], 1);
+	long * q = a.allocate(1);
+	for(int i = 0; i < 4; ++i){
+		if(p[i] != q){
+			a.deallocate(p[i], 1);
+		}
+	}
+	a.deallocate(q, 1);
+	return q == p[1] && std::pool_allocator<long, 4>::in_use() == 0
+		&& std::pool_allocator<long, 4>::high_water() == 4;
+}
+
+bool countsExhaustion(){
+	std::pool_allocator<short, 2> a;
+	size_t before = std::pool_exhaustions();
+	short * p = a.allocate(1);
+	short * q = a.allocate(1);
+	short * r = a.allocate(1);	//From the heap
+	*r = 3;
+	bool counted = std::pool_exhaustions() == before + 1
+		&& std::pool_allocator<short, 2>::exhaustions() == 1;
+	a.deallocate(r, 1);
+	a.deallocate(q, 1);
+	a.deallocate(p, 1);
+	return counted && std::pool_allocator<short, 2>::in_use() == 0;
+}
+
+bool canUseWithList(){
+	std::list<int, std::pool_allocator<int, 8> > l;
+	for(int i = 0; i < 20; ++i){
+		l.push_back(i);
+	}
+	l.remove(7);
+	l.pop_front();
+	l.sort();
+	int expected = 1;
+	for(std::list<int, std::pool_allocator<int, 8> >::iterator i = l.begin(); i != l.end(); ++i){
+		if(expected == 7){
+			++expected;
+		}
+		if(*i != expected){
+			return false;
+		}
+		++expected;
+	}
+	return l.size() == 18 && expected == 20;
+}
+
+bool canUseWithMapAndSet(){
+	typedef std::map<int, long, std::less<int>, std::pool_allocator<long, 16> > pool_map;
+	pool_map m;
+	std::set<int, std::less<int>, std::pool_allocator<int, 16> > s;
+	for(int i = 0; i < 32; ++i){
+		m[(i * 7) % 32] = i;
+		s.insert(i % 10);
+	}
+	m.erase(m.begin(), m.find(16));
+	return m.size() == 16 && m.begin()->first == 16 && m[23] == 17 && s.size() == 10;
+}
+
+int main(){
+	std::cout << "Beginning pool_allocator test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(reusesFreedBlocks, true);
+	TestFramework::AssertReturns<bool>(countsExhaustion, true);
+	TestFramework::AssertReturns<bool>(canUseWithList, true);
+	TestFramework::AssertReturns<bool>(canUseWithMapAndSet, true);
+
+	TestFramework::results();
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include <ring_buffer>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+#include "testframework.h"
+
+bool keepsTheLastValues(){
+	std::ring_buffer<int, 4> r;
+	for(int i = 1; i <= 10; ++i){
+		r.push_back(i);
+	}
+	if(!r.full() || r.size() != 4 || r.front() != 7 || r.back() != 10){
+		return false;
+	}
+	for(int i = 0; i < 4; ++i){
+		if(r[i] != 7 + i){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool canPopAtBothEnds(){
+	std::ring_buffer<int, 3> r;
+	r.push_back(1);
+	r.push_back(2);
+	r.push_back(3);
+	r.pop_front();
+	r.push_back(4);
+	r.pop_back();
+	r.push_front(0);
+	return r.size() == 3 && r[0] == 0 && r[1] == 2 && r[2] == 3;
+}
+
+bool canIterateAcrossTheWrap(){
+	std::ring_buffer<int, 5> r;
+	for(int i = 0; i < 8; ++i){
+		r.push_back(i);
+	}
+	int expected = 3;
+	for(std::ring_buffer<int, 5>::const_iterator i = r.begin(); i != r.end(); ++i){
+		if(*i != expected++){
+			return false;
+		}
+	}
+	std::ring_buffer<int, 5>::reverse_iterator ri = r.rbegin();
+	return *ri == 7 && r.end() - r.begin() == 5 && std::accumulate(r.begin(), r.end(), 0) == 25;
+}
+
+bool canSortInPlace(){
+	//The median of the last seven readings
+	std::ring_buffer<int, 7> r;
+	int readings[] = {50, 40, 30, 7, 1, 6, 2, 5, 4, 3};
+	for(int i = 0; i < 10; ++i){
+		r.push_back(readings[i]);
+	}
+	std::nth_element(r.begin(), r.begin() + 3, r.end());
+	if(r[3] != 4){
+		return false;
+	}
+	std::sort(r.begin(), r.end());
+	for(int i = 0; i < 7; ++i){
+		if(r[i] != i + 1){
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(){
+	std::cout << "Beginning ring_buffer test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(keepsTheLastValues, true);
+	TestFramework::AssertReturns<bool>(canPopAtBothEnds, true);
+	TestFramework::AssertReturns<bool>(canIterateAcrossTheWrap, true);
+	TestFramework::AssertReturns<bool>(canSortInPlace, true);
+
+	TestFramework::results();
+
+	return 0;
+}
@@ -335,6 +335,40 @@ int main(){
 		std::cout << "Set a !>= b" << std::endl;
 	}
 
+	//Larger sets, inserted in scrambled order
+	a.clear();
+	for(z = 0; z < 500; ++z){
+		a.insert( (z * 263) % 500 );
+	}
+	for(z = 0; z < 500; z += 2){
+		a.erase(z);
+	}
+	z = 1;
+	for(i = a.begin(); i != a.end() && *i == z; ++i){
+		z += 2;
+	}
+	std::cout << "Large set: " << a.size() << " elements, ";
+	if(i == a.end() && z == 501){
+		std::cout << "in order" << std::endl;
+	}else{
+		std::cout << "ERROR - out of order at " << z << std::endl;
+	}
+	std::cout << "Large set lower_bound(250): " << *a.lower_bound(250) << " should read 251" << std::endl;
+
+	std::multiset<int> m;
+	for(z = 0; z < 300; ++z){
+		m.insert(z % 30);
+	}
+	std::pair<std::multiset<int>::iterator, std::multiset<int>::iterator> range = m.equal_range(7);
+	z = 0;
+	while(range.first != range.second){
+		++z;
+		++range.first;
+	}
+	std::cout << "Multiset: " << m.count(7) << " and " << z << " should read 10" << std::endl;
+	m.erase(7);
+	std::cout << "Multiset after erase: " << m.size() << " should read 290" << std::endl;
+
 	TEST_A test_a;
 	z = test_a.f();
 
@@ -0,0 +1,151 @@
+#include <spsc_queue>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include "testframework.h"
+
+bool keepsTheOrder(){
+	std::spsc_queue<int, 8> q;
+	for(int i = 0; i < 5; ++i){
+		q.push(i);
+	}
+	int value = -1;
+	for(int i = 0; i < 5; ++i){
+		if(!q.pop(value) || value != i){
+			return false;
+		}
+	}
+	return q.empty() && !q.pop(value) && value == 4;
+}
+
+bool refusesWhenFull(){
+	std::spsc_queue<int, 4> q;
+	for(int i = 0; i < 4; ++i){
+		if(!q.push(i)){
+			return false;
+		}
+	}
+	int value;
+	if(q.push(4) || !q.full() || q.size() != 4){
+		return false;
+	}
+	q.pop(value);
+	return value == 0 && q.push(4) && q.full();
+}
+
+bool wrapsTheByteIndices(){
+	//128 elements still have byte indices, these wrap every 256 values
+	std::spsc_queue<int, 128> q;
+	int value;
+	if(sizeof(std::spsc_queue<int, 128>::index_type) != 1
+		|| sizeof(std::spsc_queue<int, 256>::index_type) != sizeof(size_t))
+	{
+		return false;
+	}
+	for(int i = 0; i < 1000; ++i){
+		q.push(i);
+		q.push(-i);
+		if(q.size() != 2 || !q.pop(value) || value != i || !q.pop(value) || value != -i){
+			return false;
+		}
+	}
+	for(int i = 0; i < 128; ++i){
+		q.push(i);
+	}
+	return q.full() && q.size() == 128 && !q.push(128);
+}
+
+bool clearDropsAll(){
+	std::spsc_queue<char, 16> q;
+	q.push('a');
+	q.push('b');
+	q.clear();
+	char value = 0;
+	return q.empty() && !q.pop(value) && q.push('c') && q.pop(value) && value == 'c';
+}
+
+//A sample of several bytes, a torn or early read breaks the check sum
+struct Sample{
+	unsigned long int sequence;
+	long int force;
+	unsigned long int check;
+};
+
+const unsigned long int samples = 200000;
+
+template <size_t N> struct Stress{
+	std::spsc_queue<Sample, N> queue;
+	unsigned long int received;
+	bool in_order;
+};
+
+template <size_t N> void * produce(void * p){
+	Stress<N> * s = static_cast<Stress<N> *>(p);
+	for(unsigned long int i = 0; i < samples; ++i){
+		Sample sample;
+		sample.sequence = i;
+		sample.force = static_cast<long int>(i * 7919 % 2003) - 1000;
+		sample.check = sample.sequence ^ static_cast<unsigned long int>(sample.force);
+		while(!s->queue.push(sample)){
+			sched_yield();	//Full, the consumer is behind
+		}
+	}
+	return 0;
+}
+
+template <size_t N> void * consume(void * p){
+	Stress<N> * s = static_cast<Stress<N> *>(p);
+	Sample sample;
+	while(s->received < samples){
+		if(!s->queue.pop(sample)){
+			sched_yield();
+			continue;
+		}
+		if(sample.sequence != s->received
+			|| sample.check != (sample.sequence ^ static_cast<unsigned long int>(sample.force)))
+		{
+			s->in_order = false;
+		}
+		++s->received;
+	}
+	return 0;
+}
+
+template <size_t N> bool stress(){
+	Stress<N> s;
+	s.received = 0;
+	s.in_order = true;
+	pthread_t producer;
+	pthread_t consumer;
+	if(pthread_create(&consumer, 0, consume<N>, &s) != 0 || pthread_create(&producer, 0, produce<N>, &s) != 0){
+		return false;
+	}
+	pthread_join(producer, 0);
+	pthread_join(consumer, 0);
+	return s.in_order && s.received == samples && s.queue.empty();
+}
+
+bool twoThreadsByteIndices(){
+	return stress<4>() && stress<128>();
+}
+
+bool twoThreadsWideIndices(){
+	return stress<1024>();
+}
+
+int main(){
+	std::cout << "Beginning spsc_queue test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(keepsTheOrder, true);
+	TestFramework::AssertReturns<bool>(refusesWhenFull, true);
+	TestFramework::AssertReturns<bool>(wrapsTheByteIndices, true);
+	TestFramework::AssertReturns<bool>(clearDropsAll, true);
+	TestFramework::AssertReturns<bool>(twoThreadsByteIndices, true);
+	TestFramework::AssertReturns<bool>(twoThreadsWideIndices, true);
+
+	TestFramework::results();
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include <static_vector>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include "testframework.h"
+
+class counted{
+public:
+	static int alive;
+	counted(int i = 0) : num(i) { ++alive; }
+	counted(const counted & c) : num(c.num) { ++alive; }
+	~counted() { --alive; }
+	counted & operator=(const counted & c) { num = c.num; return *this; }
+	bool operator<(const counted & c) const { return num < c.num; }
+	int num;
+};
+
+int counted::alive = 0;
+
+bool canPushAndPop(){
+	std::static_vector<int, 4> v;
+	if(!v.empty() || v.capacity() != 4){
+		return false;
+	}
+	v.push_back(1);
+	v.push_back(2);
+	v.push_back(3);
+	v.push_back(4);
+	if(!v.full() || v.size() != 4 || v.front() != 1 || v.back() != 4){
+		return false;
+	}
+	v.pop_back();
+	return !v.full() && v.size() == 3 && v.back() == 3 && v.at(2) == 3;
+}
+
+bool canInsertAndErase(){
+	std::static_vector<int, 8> v = {1, 2, 5, 6};
+	int more[] = {3, 4};
+	v.insert(v.begin() + 2, more, more + 2);
+	v.insert(v.end(), 7);
+	v.insert(v.begin(), 1, 0);
+	for(int i = 0; i < 8; ++i){
+		if(v[i] != i){
+			return false;
+		}
+	}
+	v.erase(v.begin() + 1, v.begin() + 3);
+	v.erase(v.begin());
+	return v.size() == 5 && v.front() == 3 && v.back() == 7;
+}
+
+bool canSortAndSearch(){
+	std::static_vector<int, 32> v;
+	for(int i = 0; i < 32; ++i){
+		v.push_back((i * 13) % 32);
+	}
+	std::sort(v.begin(), v.end());
+	for(int i = 0; i < 32; ++i){
+		if(v[i] != i){
+			return false;
+		}
+	}
+	return std::binary_search(v.begin(), v.end(), 17) && *std::max_element(v.begin(), v.end()) == 31;
+}
+
+bool destroysEveryElement(){
+	{
+		std::static_vector<counted, 6> v(3, counted(7));
+		v.push_back(counted(1));
+		v.erase(v.begin());
+		std::static_vector<counted, 6> w(v);
+		w.resize(6);
+		w.resize(2);
+		std::sort(w.begin(), w.end());
+		if(counted::alive != 5){
+			return false;
+		}
+	}
+	return counted::alive == 0;
+}
+
+#ifdef __UCLIBCXX_EXCEPTION_SUPPORT__
+//Reads an array once, like an istream_iterator
+class single_pass : public std::iterator<std::input_iterator_tag, int>{
+public:
+	single_pass(const int * p) : p(p) { }
+	int operator*() const { return *p; }
+	single_pass & operator++() { ++p; return *this; }
+	bool operator!=(const single_pass & s) const { return p != s.p; }
+	const int * p;
+};
+
+template <class InputIterator> bool insertFails(std::static_vector<int, 6> & v, InputIterator first, InputIterator last){
+	try{
+		v.insert(v.begin() + 1, first, last);
+	}catch(std::length_error &){
+		return true;
+	}
+	return false;
+}
+
+bool keepsElementsWhenRangeDoesNotFit(){
+	std::static_vector<int, 6> v = {1, 2, 3, 4};
+	int more[] = {5, 6, 7};
+	if(!insertFails(v, more, more + 3) || !insertFails(v, single_pass(more), single_pass(more + 3))){
+		return false;
+	}
+	return v.size() == 4 && v[0] == 1 && v[1] == 2 && v[2] == 3 && v[3] == 4;
+}
+#endif
+
+bool canCompare(){
+	std::static_vector<int, 4> a = {1, 2, 3};
+	std::static_vector<int, 4> b = {1, 2, 4};
+	std::static_vector<int, 4> c(a);
+	return a == c && a != b && a < b && b > c && a <= c;
+}
+
+int main(){
+	std::cout << "Beginning static_vector test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(canPushAndPop, true);
+	TestFramework::AssertReturns<bool>(canInsertAndErase, true);
+	TestFramework::AssertReturns<bool>(canSortAndSearch, true);
+	TestFramework::AssertReturns<bool>(destroysEveryElement, true);
+	TestFramework::AssertReturns<bool>(canCompare, true);
+#ifdef __UCLIBCXX_EXCEPTION_SUPPORT__
+	TestFramework::AssertReturns<bool>(keepsElementsWhenRangeDoesNotFit, true);
+#endif
+
+	TestFramework::results();
+
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include <string>
 #include <iostream>
+#include <stdexcept>
 #include "testframework.h"
 
 bool checkStringCompareEquals(){
@@ -306,6 +307,67 @@ bool checkFindLastOfThis(){
 	return 42 == retval;
 }
 
+bool checkFindEmptyNeedle(){
+	std::string a = "Needle";
+	return a.find("", 3) == 3 && a.find("", 6) == 6 && a.find("", 7) == std::string::npos;
+}
+
+bool checkFindNeedleAtEnd(){
+	std::string a = "aaaaab";
+	return a.find("ab") == 4 && a.find("ab", 5) == std::string::npos && a.find('b', 5) == 5;
+}
+
+bool checkFindBuffer(){
+	std::string a = "step 12 of 12";
+	return a.find("12 of", 0, 2) == 5 && a.find("12 of", 6, 2) == 11;
+}
+
+bool checkRfindAtPos(){
+	std::string a = "abcabc";
+	return a.rfind("abc", 3) == 3 && a.rfind("abc", 2) == 0 && a.rfind('c', 2) == 2
+		&& a.rfind("abcd") == std::string::npos && a.rfind("", 2) == 2;
+}
+
+bool checkFindLastOfAtPos(){
+	std::string a = "This is the string";
+	return a.find_last_of("s", 6) == 6 && a.find_last_of("s", 5) == 3
+		&& a.find_last_not_of("T", 0) == std::string::npos;
+}
+
+bool checkFindInEmptyString(){
+	std::string a;
+	return a.find('x') == std::string::npos && a.rfind("x") == std::string::npos
+		&& a.find_last_of("x") == std::string::npos && a.find("") == 0;
+}
+
+bool checkFindEmbeddedNull(){
+	std::string a("ab\0cd\0ef", 8);
+	return a.find(std::string("\0e", 2)) == 5 && a.rfind('\0') == 5 && a.find_first_of(std::string("\0", 1)) == 2;
+}
+
+bool checkCompareEmbeddedNull(){
+	std::string a("ab\0c", 4);
+	std::string b("ab\0d", 4);
+	return a.compare(b) < 0 && b.compare(a) > 0 && a.compare(0, 2, "ab") == 0;
+}
+
+bool checkCompareSubstrings(){
+	std::string a = "Tommi Maekitalo";
+	std::string b = "Maekitalo";
+	return a.compare(6, std::string::npos, b) == 0 && a.compare(6, 3, b, 0, 3) == 0
+		&& a.compare(6, 4, b, 0, 3) > 0 && a.compare("Tommi") > 0 && a.compare(0, 5, "Tommi") == 0;
+}
+
+bool checkCompareOutOfRange(){
+	std::string a = "short";
+	try{
+		a.compare(6, 1, "x");
+	}catch(std::out_of_range &){
+		return true;
+	}
+	return false;
+}
+
 bool checkFindFirstNotOfThe(){
 	std::string a = "This is the string we are searching through";
 	std::string b = "the";
@@ -438,6 +500,30 @@ bool checkAssignIterator() {
 	return b == "is is a ";
 }
 
+bool checkShortStringIsLocal() {
+	std::string a = "SCHNEIDEN";
+	const char * before = a.data();
+	a += "12345";
+	return a.data() == before && a.capacity() == __UCLIBCXX_STRING_SSO_SIZE__
+		&& a == "SCHNEIDEN12345" && std::string(a.c_str()) == a;
+}
+
+bool checkLongStringShrinksToLocal() {
+	std::string a = "A string longer than the local buffer";
+	a.erase(6);
+	a.shrink_to_fit();
+	return a == "A stri" && a.capacity() == __UCLIBCXX_STRING_SSO_SIZE__;
+}
+
+bool checkSwapLocalAndHeap() {
+	std::string a = "PULSEN";
+	std::string b = "A string longer than the local buffer";
+	a.swap(b);
+	std::string c(a);
+	b.swap(c);
+	return a == "A string longer than the local buffer" && c == "PULSEN" && b == a;
+}
+
 int main(){
 	TestFramework::init();
 
@@ -522,6 +608,17 @@ int main(){
 	TestFramework::AssertReturns<bool>(checkFindLastOfQ, true);
 	TestFramework::AssertReturns<bool>(checkFindLastOfThis, true);
 
+	TestFramework::AssertReturns<bool>(checkFindEmptyNeedle, true);
+	TestFramework::AssertReturns<bool>(checkFindNeedleAtEnd, true);
+	TestFramework::AssertReturns<bool>(checkFindBuffer, true);
+	TestFramework::AssertReturns<bool>(checkRfindAtPos, true);
+	TestFramework::AssertReturns<bool>(checkFindLastOfAtPos, true);
+	TestFramework::AssertReturns<bool>(checkFindInEmptyString, true);
+	TestFramework::AssertReturns<bool>(checkFindEmbeddedNull, true);
+	TestFramework::AssertReturns<bool>(checkCompareEmbeddedNull, true);
+	TestFramework::AssertReturns<bool>(checkCompareSubstrings, true);
+	TestFramework::AssertReturns<bool>(checkCompareOutOfRange, true);
+
 	TestFramework::AssertReturns<bool>(checkFindFirstNotOfThe, true);
 	TestFramework::AssertReturns<bool>(checkFindFirstNotOfCharG, true);
 	TestFramework::AssertReturns<bool>(checkFindFirstNotOfSearch, true);
@@ -546,6 +643,10 @@ int main(){
 	TestFramework::AssertReturns<bool>(checkAssignBuffer, true);
 	TestFramework::AssertReturns<bool>(checkAssignIterator, true);
 
+	TestFramework::AssertReturns<bool>(checkShortStringIsLocal, true);
+	TestFramework::AssertReturns<bool>(checkLongStringShrinksToLocal, true);
+	TestFramework::AssertReturns<bool>(checkSwapLocalAndHeap, true);
+
 	TestFramework::results();
 
 	return 0;
@@ -0,0 +1,141 @@
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include <set>
+#include <iterator>
+#include <iostream>
+#include "testframework.h"
+
+bool canInsertAndFind(){
+	std::unordered_map<int, int> m;
+	for(int i = 0; i < 100; ++i){
+		m[i * 16] = i;
+	}
+	if(m.size() != 100 || m.load_factor() > m.max_load_factor()){
+		return false;
+	}
+	for(int i = 0; i < 100; ++i){
+		if(m.find(i * 16) == m.end() || m.at(i * 16) != i){
+			return false;
+		}
+	}
+	return m.find(5) == m.end() && m.count(32) == 1 && !m.insert(std::make_pair(32, 0)).second;
+}
+
+bool eraseKeepsTheRestReachable(){
+	std::unordered_map<int, int> m;
+	for(int i = 0; i < 200; ++i){
+		m[i] = i;
+	}
+	for(int i = 0; i < 200; i += 3){
+		m.erase(i);
+	}
+	std::unordered_map<int, int>::iterator i = m.begin();
+	while(i != m.end()){
+		if(i->first % 3 == 1){
+			i = m.erase(i);
+		}else{
+			++i;
+		}
+	}
+	for(int k = 0; k < 200; ++k){
+		if((m.count(k) == 1) != (k % 3 == 2)){
+			return false;
+		}
+	}
+	m.erase(m.begin(), m.end());
+	return m.empty() && m.begin() == m.end();
+}
+
+//Erases [first, last) at the positions a and b of the iteration and goes on with the
+//returned iterator: it has to reach every element that followed the range
+template <class Map> bool eraseRangeContinuesBehindIt(Map & m, size_t a, size_t b){
+	std::vector<int> order;
+	for(typename Map::iterator i = m.begin(); i != m.end(); ++i){
+		order.push_back(i->first);
+	}
+	typename Map::iterator first = m.begin();
+	std::advance(first, a);
+	typename Map::iterator last = first;
+	std::advance(last, b - a);
+	typename Map::iterator i = m.erase(first, last);
+	std::set<int> seen;
+	for(; i != m.end(); ++i){
+		seen.insert(i->first);
+	}
+	for(size_t k = 0; k < order.size(); ++k){
+		bool erased = (k >= a && k < b);
+		bool found = (m.count(order[k]) == 1);
+		bool reached = (seen.count(order[k]) == 1);
+		if(erased == found || (erased && reached) || (k >= b && !reached)){
+			return false;
+		}
+	}
+	return m.size() == order.size() - (b - a);
+}
+
+bool eraseRangeReturnsTheNextElement(){
+	unsigned long int random = 1;
+	for(int trial = 0; trial < 2000; ++trial){
+		std::static_unordered_map<int, int, 24> fixed;
+		std::unordered_map<int, int> heap;
+		size_t n = 1 + trial % 24;
+		while(fixed.size() < n){
+			random = random * 1103515245 + 12345;
+			int key = static_cast<int>((random >> 8) % 200);
+			fixed[key] = key;
+			heap[key] = key;
+		}
+		random = random * 1103515245 + 12345;
+		size_t a = (random >> 8) % n;
+		size_t b = a + (random >> 16) % (n - a + 1);
+		if(!eraseRangeContinuesBehindIt(fixed, a, b) || !eraseRangeContinuesBehindIt(heap, a, b)){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool canUseStringKeys(){
+	std::unordered_map<std::string, int> ids = { {"SCHNEIDEN", 1}, {"PULSEN", 2}, {"b1", 3} };
+	std::unordered_set<std::string> names(ids.size());
+	for(std::unordered_map<std::string, int>::iterator i = ids.begin(); i != ids.end(); ++i){
+		names.insert(i->first);
+	}
+	std::unordered_map<std::string, int> copy(ids);
+	copy["b1"] = 4;
+	return ids["PULSEN"] == 2 && names.count("SCHNEIDEN") == 1 && names.count("RESET") == 0
+		&& ids.size() == 3 && copy != ids;
+}
+
+bool fixedCapacityIsAllocationFree(){
+	typedef std::static_unordered_map<unsigned char, const char *, 24> table;
+	table t;
+	std::static_unordered_set<long, 5> s = { 1, 2, 3 };
+	for(unsigned char i = 0; !t.full(); ++i){
+		t[i] = "x";
+	}
+	table copy(t);
+	copy.erase(3);
+	copy.swap(t);
+	return t.max_size() >= 24 && copy.size() == t.max_size() && t.size() == copy.size() - 1
+		&& t.count(3) == 0 && sizeof(table) >= 32 * sizeof(table::value_type)
+		&& s.count(2) == 1 && s.count(4) == 0;
+}
+
+int main(){
+	std::cout << "Beginning unordered_map test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(canInsertAndFind, true);
+	TestFramework::AssertReturns<bool>(eraseKeepsTheRestReachable, true);
+	TestFramework::AssertReturns<bool>(eraseRangeReturnsTheNextElement, true);
+	TestFramework::AssertReturns<bool>(canUseStringKeys, true);
+	TestFramework::AssertReturns<bool>(fixedCapacityIsAllocationFree, true);
+
+	TestFramework::results();
+
+	return 0;
+}
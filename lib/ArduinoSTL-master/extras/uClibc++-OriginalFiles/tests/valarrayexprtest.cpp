@@ -0,0 +1,135 @@
+#include <valarray>
+#include <static_valarray>
+#include <stdexcept>
+#include <iostream>
+#include "testframework.h"
+
+std::valarray<int> ramp(int n){
+	std::valarray<int> retval(n);
+	for(int i = 0; i < n; ++i){
+		retval[i] = i;
+	}
+	return retval;
+}
+
+bool offsetAndScale(){
+	std::valarray<int> a = ramp(10);
+	std::valarray<int> b = (a - 3) * 4 + a / 2;
+	for(int i = 0; i < 10; ++i){
+		if(b[i] != (i - 3) * 4 + i / 2){
+			return false;
+		}
+	}
+	return b.size() == 10;
+}
+
+bool scalarOnTheLeft(){
+	std::valarray<int> a = ramp(5);
+	std::valarray<int> b = 10 - a;
+	std::valarray<int> c = 2 * a + 1;
+	std::valarray<int> d = 1 << a;
+	return b[0] == 10 && b[4] == 6 && c[4] == 9 && d[4] == 16;
+}
+
+bool assignToOperand(){
+	std::valarray<int> a = ramp(6);
+	a = a * 2 + a;
+	a += a * a;
+	std::valarray<int> b(3);
+	b = a + 1;
+	return a[5] == 15 + 225 && a[1] == 3 + 9 && b.size() == 6 && b[5] == 241;
+}
+
+bool unaryOperators(){
+	std::valarray<int> a = ramp(4);
+	std::valarray<int> b = -(a + 1);
+	std::valarray<int> c = ~a;
+	std::valarray<bool> d = !(a - 2);
+	return b[0] == -1 && b[3] == -4 && c[2] == ~2 && !d[0] && d[2] && !d[3];
+}
+
+bool comparisons(){
+	std::valarray<int> a = ramp(10);
+	std::valarray<bool> m = (a > 2) && (a * 2 < 14);
+	std::valarray<bool> n = a == 5 || a != a;
+	int count = 0;
+	for(size_t i = 0; i < m.size(); ++i){
+		count += m[i];
+	}
+	return count == 4 && m[3] && m[6] && !m[7] && n[5] && !n[4];
+}
+
+bool mathFunctions(){
+	std::valarray<double> a(4);
+	for(int i = 0; i < 4; ++i){
+		a[i] = i + 1;
+	}
+	std::valarray<double> b = sqrt(a * a) - a;
+	std::valarray<double> c = pow(a, 2.0) + abs(-a);
+	std::valarray<double> d = atan2(0.0 * a, a) + exp(a - a);
+	return b.max() == 0 && b.min() == 0 && c[3] == 20 && d[2] == 1;
+}
+
+bool reductionsOfExpressions(){
+	std::valarray<int> a = ramp(10);
+	return ((a - 5) * 2).sum() == -10 && (a - 5).min() == -5 && (a * a).max() == 81
+		&& (a + 1)[9] == 10 && (a + 1).size() == 10;
+}
+
+bool staticValarrayExpressions(){
+	std::static_valarray<float, 16> raw(8);
+	for(int i = 0; i < 8; ++i){
+		raw[i] = 100 + i;
+	}
+	std::static_valarray<float, 16> force = (raw - 100.0f) * 0.5f;
+	force -= force.min();
+	force *= 2;
+	std::valarray<float> ones(1.0f, 8);
+	force += ones;
+	return force.size() == 8 && force.max_size() == 16 && force[0] == 1 && force[7] == 8
+		&& force.sum() == 36;
+}
+
+bool staticValarrayMovingAverage(){
+	const float samples[] = { 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4 };
+	std::static_valarray<float, 8> x0(samples, 8);
+	std::static_valarray<float, 8> x1(samples + 1, 8);
+	std::static_valarray<float, 8> x2(samples + 2, 8);
+	std::static_valarray<float, 8> x3(samples + 3, 8);
+	std::static_valarray<float, 8> average = (x0 + x1 + x2 + x3) / 4.0f;
+	return average.min() == 6 && average.max() == 6;
+}
+
+bool staticValarrayCapacity(){
+	std::static_valarray<int, 4> a(4);
+	std::valarray<int> b = ramp(5);
+	bool thrown = false;
+	try{
+		a = b + 1;
+	}catch(std::length_error & e){
+		thrown = true;
+	}
+	a.resize(2, 7);
+	return thrown && a.size() == 2 && a[0] == 7 && a[1] == 7;
+}
+
+int main(){
+	std::cout << "Beginning valarray expression test" << std::endl;
+
+	TestFramework::init();
+
+	TestFramework::AssertReturns<bool>(offsetAndScale, true);
+	TestFramework::AssertReturns<bool>(scalarOnTheLeft, true);
+	TestFramework::AssertReturns<bool>(assignToOperand, true);
+	TestFramework::AssertReturns<bool>(unaryOperators, true);
+	TestFramework::AssertReturns<bool>(comparisons, true);
+	TestFramework::AssertReturns<bool>(mathFunctions, true);
+	TestFramework::AssertReturns<bool>(reductionsOfExpressions, true);
+	TestFramework::AssertReturns<bool>(staticValarrayExpressions, true);
+	TestFramework::AssertReturns<bool>(staticValarrayMovingAverage, true);
+	TestFramework::AssertReturns<bool>(staticValarrayCapacity, true);
+
+	TestFramework::results();
+
+	return 0;
+}
@@ -47,6 +47,36 @@ bool canCompareConstNonConstIter() {
 	return true;
 }
 
+bool growsByThePolicy() {
+	std::vector<int> v;
+	int reallocations = 0;
+	for(int i = 0; i < 1000; ++i){
+		std::vector<int>::size_type capacity = v.capacity();
+		v.push_back(i);
+		if(v.capacity() != capacity){
+			++reallocations;
+		}
+	}
+#if __UCLIBCXX_VECTOR_GROWTH__ == __UCLIBCXX_STL_GROWTH_GEOMETRIC__
+	return reallocations < 20 && v.capacity() <= 1500;
+#else
+	return reallocations > 100;
+#endif
+}
+
+bool canShrinkToFit() {
+	std::vector<int> v(100, 5);
+	v.resize(10);
+	v.shrink_to_fit();
+	if(v.capacity() != 10 || v.size() != 10 || v[9] != 5){
+		return false;
+	}
+	v.clear();
+	v.shrink_to_fit();
+	v.push_back(3);
+	return v.capacity() > 0 && v.size() == 1 && v[0] == 3;
+}
+
 
 int main(){
 	std::vector<char, std::allocator<char> > ctest;
@@ -237,6 +267,8 @@ int main(){
 	TestFramework::init();
 
         TestFramework::AssertReturns<bool>(canCompareConstNonConstIter, true);
+        TestFramework::AssertReturns<bool>(growsByThePolicy, true);
+        TestFramework::AssertReturns<bool>(canShrinkToFit, true);
 
         TestFramework::results();
 
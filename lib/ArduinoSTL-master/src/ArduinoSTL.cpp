@@ -4,20 +4,25 @@
 //
 // Configuration Help 
 //
-// If you're using a serial port that's statically declared somewhere in
-// Arduino (e.g. Serial1 on Leonardo)
-//   1. Set ARDUINOSTL_SERIAL_DEVICE to your device
-//   2. Uncomment the ARDUINOSTL_DEFAULT_CIN_COUT flag.
+// Nothing is constructed at boot unless the build asks for it, so a sketch
+// that doesn't use cin, cout or printf() pays neither RAM nor flash for them.
+// Add the flags to build_flags in platformio.ini:
 //
-// If you're using a sofware serial port:
-//   1. Set ARDUINOSTL_DEFAULT_SERIAL to NULL
-//   2. Comment out ARDUINOSTL_DEFAULT_CIN_COUT
-// Your sketch must contain delarations of cin and cout, and a call to
-// ArduinoSTL_serial.connect().
+//   -D ARDUINOSTL_DEFAULT_CIN_COUT  creates cin and cout on the serial port
+//   -D ARDUINOSTL_DEFAULT_STDIO     connects printf() and scanf() at boot
+//   -D ARDUINOSTL_DEFAULT_SERIAL=Serial1  selects another built-in port
+//
+// Without ARDUINOSTL_DEFAULT_STDIO call ArduinoSTL_Serial.connect(Serial)
+// in setup() before the first printf().
+//
+// If you're using a sofware serial port leave ARDUINOSTL_DEFAULT_CIN_COUT
+// undefined. Your sketch must contain delarations of cin and cout, and a
+// call to ArduinoSTL_Serial.connect().
 //
 
+#ifndef ARDUINOSTL_DEFAULT_SERIAL
 #define ARDUINOSTL_DEFAULT_SERIAL Serial
-#define ARDUINOSTL_DEFAULT_CIN_COUT
+#endif
 
 using namespace std; 
 
@@ -29,6 +34,14 @@ namespace std
   ohserialstream cout(ARDUINOSTL_DEFAULT_SERIAL);
   ihserialstream cin(ARDUINOSTL_DEFAULT_SERIAL);
 }
+
+namespace
+{
+  // cout is buffered: a prompt without endl has to show up before cin waits
+  struct Cin_tie {
+    Cin_tie() { std::cin.tie(&std::cout); }
+  } cin_tie;
+}
 #endif // ARDUINOSTL_DEFAULT_CIN_COUT
 
 /*
@@ -42,7 +55,12 @@ namespace std
  */
 #if defined(ARDUINO_ARCH_AVR)
 
+#ifdef ARDUINOSTL_DEFAULT_STDIO
 ArduinoSTL_STDIO ArduinoSTL_Serial(ARDUINOSTL_DEFAULT_SERIAL);
+#else
+// Constant initialized, no constructor runs at boot
+ArduinoSTL_STDIO ArduinoSTL_Serial;
+#endif
 
 // arduino_putchar(char, FILE*) 
 //   Output a single character to the serial port. 
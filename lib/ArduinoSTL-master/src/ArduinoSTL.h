@@ -11,8 +11,8 @@
 
 #include <serstream>
 
-// Create cout and cin.. there doesn't seem to be a way
-// to control what serial device at runtime. Grr.
+// Defined by ArduinoSTL.cpp when ARDUINOSTL_DEFAULT_CIN_COUT is set,
+// otherwise by the sketch
 namespace std
 {
   extern ohserialstream cout;
@@ -23,6 +23,9 @@ namespace std
 
 class ArduinoSTL_STDIO {
 public:
+  // Not connected, printf() has no output until connect() is called
+  constexpr ArduinoSTL_STDIO() : uart(NULL), file(NULL) {}
+
   // Initialize STDIO using a pointer to whatever Serial is. 
   // Serial.begin() must be called at some point. 
   ArduinoSTL_STDIO(Stream *u) : file(NULL) {
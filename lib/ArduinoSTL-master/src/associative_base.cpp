@@ -21,6 +21,311 @@
 
 namespace std{
 
+	// Red-black tree balancing, shared by all __rb_tree instantiations.
+	// The header node: parent is the root, left the leftmost and right the
+	// rightmost node.  It is red, the root is black.
 
+	static void __rb_tree_rotate_left(__rb_tree_node_base * x, __rb_tree_node_base *& root){
+		__rb_tree_node_base * y = x->right;
+		x->right = y->left;
+		if(y->left != 0){
+			y->left->parent = x;
+		}
+		y->parent = x->parent;
+		if(x == root){
+			root = y;
+		}else if(x == x->parent->left){
+			x->parent->left = y;
+		}else{
+			x->parent->right = y;
+		}
+		y->left = x;
+		x->parent = y;
+	}
+
+	static void __rb_tree_rotate_right(__rb_tree_node_base * x, __rb_tree_node_base *& root){
+		__rb_tree_node_base * y = x->left;
+		x->left = y->right;
+		if(y->right != 0){
+			y->right->parent = x;
+		}
+		y->parent = x->parent;
+		if(x == root){
+			root = y;
+		}else if(x == x->parent->right){
+			x->parent->right = y;
+		}else{
+			x->parent->left = y;
+		}
+		y->right = x;
+		x->parent = y;
+	}
+
+	static bool __rb_tree_is_red(const __rb_tree_node_base * x){
+		return x != 0 && x->red;
+	}
+
+	//The header is the only red node whose parent is 0 (empty tree) or has it as parent
+	static bool __rb_tree_is_header(const __rb_tree_node_base * x){
+		return x->red && (x->parent == 0 || x->parent->parent == x);
+	}
+
+	_UCXXEXPORT __rb_tree_node_base * __rb_tree_increment(__rb_tree_node_base * x){
+		//end() stays end(), the leftmost of an empty tree is the header itself
+		if(__rb_tree_is_header(x)){
+			return x;
+		}
+		if(x->right != 0){
+			x = x->right;
+			while(x->left != 0){
+				x = x->left;
+			}
+			return x;
+		}
+		__rb_tree_node_base * y = x->parent;
+		while(x == y->right){
+			x = y;
+			y = y->parent;
+		}
+		//Special case: incrementing the root without right child goes to the header
+		if(x->right != y){
+			x = y;
+		}
+		return x;
+	}
+
+	_UCXXEXPORT __rb_tree_node_base * __rb_tree_decrement(__rb_tree_node_base * x){
+		//end() - 1 is the rightmost node
+		if(__rb_tree_is_header(x)){
+			return x->right;
+		}
+		if(x->left != 0){
+			x = x->left;
+			while(x->right != 0){
+				x = x->right;
+			}
+			return x;
+		}
+		__rb_tree_node_base * y = x->parent;
+		while(x == y->left){
+			x = y;
+			y = y->parent;
+		}
+		return y;
+	}
+
+	_UCXXEXPORT void __rb_tree_insert_and_rebalance(bool insert_left, __rb_tree_node_base * x,
+		__rb_tree_node_base * parent, __rb_tree_node_base & header)
+	{
+		__rb_tree_node_base *& root = header.parent;
+
+		x->parent = parent;
+		x->left = 0;
+		x->right = 0;
+		x->red = true;
+
+		if(insert_left){
+			parent->left = x;	//Also sets the leftmost of an empty tree
+			if(parent == &header){
+				header.parent = x;
+				header.right = x;
+			}else if(parent == header.left){
+				header.left = x;
+			}
+		}else{
+			parent->right = x;
+			if(parent == header.right){
+				header.right = x;
+			}
+		}
+
+		while(x != root && x->parent->red){
+			__rb_tree_node_base * grandparent = x->parent->parent;
+			if(x->parent == grandparent->left){
+				__rb_tree_node_base * uncle = grandparent->right;
+				if(__rb_tree_is_red(uncle)){
+					x->parent->red = false;
+					uncle->red = false;
+					grandparent->red = true;
+					x = grandparent;
+				}else{
+					if(x == x->parent->right){
+						x = x->parent;
+						__rb_tree_rotate_left(x, root);
+					}
+					x->parent->red = false;
+					grandparent->red = true;
+					__rb_tree_rotate_right(grandparent, root);
+				}
+			}else{
+				__rb_tree_node_base * uncle = grandparent->left;
+				if(__rb_tree_is_red(uncle)){
+					x->parent->red = false;
+					uncle->red = false;
+					grandparent->red = true;
+					x = grandparent;
+				}else{
+					if(x == x->parent->left){
+						x = x->parent;
+						__rb_tree_rotate_right(x, root);
+					}
+					x->parent->red = false;
+					grandparent->red = true;
+					__rb_tree_rotate_left(grandparent, root);
+				}
+			}
+		}
+		root->red = false;
+	}
+
+	_UCXXEXPORT __rb_tree_node_base * __rb_tree_rebalance_for_erase(__rb_tree_node_base * z,
+		__rb_tree_node_base & header)
+	{
+		__rb_tree_node_base *& root = header.parent;
+		__rb_tree_node_base *& leftmost = header.left;
+		__rb_tree_node_base *& rightmost = header.right;
+		__rb_tree_node_base * y = z;
+		__rb_tree_node_base * x = 0;
+		__rb_tree_node_base * x_parent = 0;
+
+		//y: the node that gets unlinked, z itself or its successor
+		if(y->left == 0){
+			x = y->right;
+		}else if(y->right == 0){
+			x = y->left;
+		}else{
+			y = y->right;
+			while(y->left != 0){
+				y = y->left;
+			}
+			x = y->right;
+		}
+
+		if(y != z){
+			//Two children: the successor y takes the place of z
+			z->left->parent = y;
+			y->left = z->left;
+			if(y != z->right){
+				x_parent = y->parent;
+				if(x != 0){
+					x->parent = y->parent;
+				}
+				y->parent->left = x;
+				y->right = z->right;
+				z->right->parent = y;
+			}else{
+				x_parent = y;
+			}
+			if(root == z){
+				root = y;
+			}else if(z->parent->left == z){
+				z->parent->left = y;
+			}else{
+				z->parent->right = y;
+			}
+			y->parent = z->parent;
+			bool red = y->red;
+			y->red = z->red;
+			z->red = red;
+			y = z;
+		}else{
+			x_parent = y->parent;
+			if(x != 0){
+				x->parent = y->parent;
+			}
+			if(root == z){
+				root = x;
+			}else if(z->parent->left == z){
+				z->parent->left = x;
+			}else{
+				z->parent->right = x;
+			}
+			if(leftmost == z){
+				if(z->right == 0){
+					leftmost = z->parent;	//The header if the tree is empty now
+				}else{
+					leftmost = x;
+					while(leftmost->left != 0){
+						leftmost = leftmost->left;
+					}
+				}
+			}
+			if(rightmost == z){
+				if(z->left == 0){
+					rightmost = z->parent;
+				}else{
+					rightmost = x;
+					while(rightmost->right != 0){
+						rightmost = rightmost->right;
+					}
+				}
+			}
+		}
+
+		//A black node is gone, x carries an extra black
+		if(!y->red){
+			while(x != root && !__rb_tree_is_red(x)){
+				if(x == x_parent->left){
+					__rb_tree_node_base * w = x_parent->right;
+					if(w->red){
+						w->red = false;
+						x_parent->red = true;
+						__rb_tree_rotate_left(x_parent, root);
+						w = x_parent->right;
+					}
+					if(!__rb_tree_is_red(w->left) && !__rb_tree_is_red(w->right)){
+						w->red = true;
+						x = x_parent;
+						x_parent = x_parent->parent;
+					}else{
+						if(!__rb_tree_is_red(w->right)){
+							w->left->red = false;
+							w->red = true;
+							__rb_tree_rotate_right(w, root);
+							w = x_parent->right;
+						}
+						w->red = x_parent->red;
+						x_parent->red = false;
+						if(w->right != 0){
+							w->right->red = false;
+						}
+						__rb_tree_rotate_left(x_parent, root);
+						break;
+					}
+				}else{
+					__rb_tree_node_base * w = x_parent->left;
+					if(w->red){
+						w->red = false;
+						x_parent->red = true;
+						__rb_tree_rotate_right(x_parent, root);
+						w = x_parent->left;
+					}
+					if(!__rb_tree_is_red(w->right) && !__rb_tree_is_red(w->left)){
+						w->red = true;
+						x = x_parent;
+						x_parent = x_parent->parent;
+					}else{
+						if(!__rb_tree_is_red(w->left)){
+							w->right->red = false;
+							w->red = true;
+							__rb_tree_rotate_left(w, root);
+							w = x_parent->left;
+						}
+						w->red = x_parent->red;
+						x_parent->red = false;
+						if(w->left != 0){
+							w->left->red = false;
+						}
+						__rb_tree_rotate_right(x_parent, root);
+						break;
+					}
+				}
+			}
+			if(x != 0){
+				x->red = false;
+			}
+		}
+		return y;
+	}
 
 }
@@ -1,67 +1,303 @@
-/* 
- * This code is taken from the Arduino Print class. 
- * 
- * printf() doesn't handle floating point types on AVR. 
- * This code helps me hack that in. It's not here permanently. 
- * 
+/*
+ * Number formatting for the char streams.
+ *
+ * printf() doesn't handle floating point types on AVR and costs about
+ * 1.5 KB of flash for the integer formats alone, so the conversions are
+ * done here digit by digit.
+ *
  */
 
 #include <ostream_helpers>
-#include <stdio.h>
 
 namespace std {
 
-int arduinoPrintFloat(double number, uint8_t digits, char *buffer, size_t buffer_size) 
-{ 
-  size_t n = 0;
-
-  if (buffer_size < 4) 
-    return 0;
-
-  if (isnan(number)) return snprintf(buffer, buffer_size, "nan");
-  if (isinf(number)) return snprintf(buffer, buffer_size, "inf");
-  if (number > 4294967040.0) return snprintf(buffer, buffer_size, "ovf");  // constant determined empirically
-  if (number <-4294967040.0) return snprintf(buffer, buffer_size, "ovf");  // constant determined empirically
-
-  // Handle negative numbers
-  if (number < 0.0) {
-    n += snprintf(&buffer[n], buffer_size-n, "-");
-    number = -number;
-  }
-
-  // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
-  for (uint8_t i=0; i<digits; ++i)
-    rounding /= 10.0;
-  
-  number += rounding;
-
-  // Extract the integer part of the number and print it
-  unsigned long int_part = (unsigned long)number;
-  double remainder = number - (double)int_part;
-  n += snprintf(&buffer[n], buffer_size-n, "%lu", int_part);
-  if (n >= buffer_size) 
-    return n; 
-
-  // Print the decimal point, but only if there are digits beyond
-  if (digits > 0) {
-    n += snprintf(&buffer[n], buffer_size-n, ".");
-    if (n >= buffer_size) 
-      return n; 
-  }
-
-  // Extract digits from the remainder one at a time
-  while (digits-- > 0)
-    {
-      remainder *= 10.0;
-      unsigned int toPrint = (unsigned int)(remainder);
-      n += snprintf(&buffer[n], buffer_size-n, "%u", toPrint);
-      if (n >= buffer_size) 
-	return n; 
-      remainder -= toPrint; 
-    }
-  
-  return n;
+namespace {
+
+	//Significant digits of a float that fit into an unsigned long.  A double
+	//of AVR is a float of 24 bits, it holds 6 to 9 digits.  No more digits are
+	//printed on any target, a higher precision() gives the same text as on AVR.
+	const int __float_significant = 9;
+
+	template <class U> size_t __format_unsigned(char * buffer, U n, bool negative, ios_base::fmtflags flags){
+		char * c = buffer;
+		unsigned char base = 10;
+		if( !(flags & ios_base::dec) ){
+			if(flags & ios_base::oct){
+				base = 8;
+			}else if(flags & ios_base::hex){
+				base = 16;
+			}
+		}
+
+		if(base == 10){
+			if(negative){
+				*c++ = '-';
+				n = 0 - n;
+			}
+		}else if( (flags & ios_base::showbase) && n != 0 ){
+			*c++ = '0';
+			if(base == 16){
+				*c++ = (flags & ios_base::uppercase) ? 'X' : 'x';
+			}
+		}
+
+		char letter = (flags & ios_base::uppercase) ? 'A' - 10 : 'a' - 10;
+		char reversed[__integer_chars];
+		size_t length = 0;
+		do{
+			unsigned char digit = n % base;
+			reversed[length++] = digit < 10 ? '0' + digit : letter + digit;
+			n /= base;
+		}while(n != 0);
+		while(length > 0){
+			*c++ = reversed[--length];
+		}
+		return c - buffer;
+	}
+
+	//Largest n with an exact 10^n: 5^n has to fit into the mantissa, that is
+	//10^10 for the float of AVR and 10^22 for a double of 53 bits
+	const int __exact_power10 = __DBL_MANT_DIG__ * 43 / 100;
+
+	//10^n for 0 <= n <= __exact_power10, every step is exact
+	double __power10(int n){
+		double p = 1;
+		for(; n > 0; --n){
+			p *= 10;
+		}
+		return p;
+	}
+
+	//a * b == high + low exactly (Dekker's product, no fused multiply-add on AVR)
+	void __exact_product(double a, double b, double & high, double & low){
+		const double split = (1UL << ((__DBL_MANT_DIG__ + 1) / 2)) + 1;
+		double t = split * a;
+		double a1 = t - (t - a);
+		double a2 = a - a1;
+		t = split * b;
+		double b1 = t - (t - b);
+		double b2 = b - b1;
+		high = a * b;
+		low = ((a1 * b1 - high) + a1 * b2 + a2 * b1) + a2 * b2;
+	}
+
+	//Nearest integer to high + low, where low is below one unit of the last
+	//place of high.  An exact half rounds to even like printf().
+	unsigned long int __round(double high, double low){
+		unsigned long int m = static_cast<unsigned long int>(high);
+		double rest = high - m;
+		if(rest == 0){
+			//high may have no bits below the units, then low holds whole units
+			long int whole = static_cast<long int>(low);
+			m += whole;
+			low -= whole;
+			if(low < 0){
+				--m;
+				low += 1;
+			}
+		}
+		double above_half = (rest - 0.5) + low;
+		if(above_half > 0 || (above_half == 0 && (m & 1) != 0)){
+			++m;
+		}
+		return m;
+	}
+
+	//f * 10^exponent rounded to an integer.  The product with an exact power
+	//of ten is kept exact, so a value close to a half rounds the right way.
+	//Beyond 10^__exact_power10 the power itself is rounded once.
+	unsigned long int __scale10(double f, int exponent){
+		for(; exponent > __exact_power10; exponent -= __exact_power10){
+			f *= __power10(__exact_power10);
+		}
+		for(; exponent < -__exact_power10; exponent += __exact_power10){
+			f /= __power10(__exact_power10);
+		}
+		double high;
+		double low;
+		if(exponent >= 0){
+			__exact_product(f, __power10(exponent), high, low);
+			return __round(high, low);
+		}
+		//f / p == m + r / p with the exact remainder r
+		double p = __power10(-exponent);
+		double m = floor(f / p);
+		__exact_product(m, p, high, low);
+		return __round(m, ((f - high) - low) / p);
+	}
+
+	//Rounds f to a multiple of 10^last and writes its digits, most significant
+	//first.  exponent is the decimal exponent of f.  Digits of the integer part
+	//below the significant ones are zeros.  Returns the number of digits, at
+	//least one.
+	int __float_digits(double f, int exponent, int last, char * digits){
+		int lowest = exponent - (__float_significant - 1);
+		if(lowest < last){
+			lowest = last;
+		}
+		unsigned long int m = __scale10(f, -lowest);
+
+		char reversed[__float_significant + 1];
+		int n = 0;
+		do{
+			reversed[n++] = '0' + m % 10;
+			m /= 10;
+		}while(m != 0);
+
+		int length = 0;
+		while(n > 0){
+			digits[length++] = reversed[--n];
+		}
+		for(; lowest > last; --lowest){
+			digits[length++] = '0';
+		}
+		return length;
+	}
+
+	//Same for fraction digits after the first one, at most the significant
+	//ones.  Corrects exponent when rounding carries into a new digit.
+	int __scientific_digits(double f, int & exponent, int & fraction, char * digits){
+		if(fraction > __float_significant - 1){
+			fraction = __float_significant - 1;
+		}
+		int length = __float_digits(f, exponent, exponent - fraction, digits);
+		for(int i = 0; i < 2 && f != 0 && length != fraction + 1; ++i){
+			exponent += length > fraction + 1 ? 1 : -1;
+			length = __float_digits(f, exponent, exponent - fraction, digits);
+		}
+		return length;
+	}
+
+}
+
+_UCXXEXPORT size_t __format_integer(char * buffer, unsigned long int n, bool negative, ios_base::fmtflags flags){
+	return __format_unsigned(buffer, n, negative, flags);
+}
+
+#ifndef __STRICT_ANSI__
+_UCXXEXPORT size_t __format_integer(char * buffer, unsigned long long int n, bool negative, ios_base::fmtflags flags){
+	return __format_unsigned(buffer, n, negative, flags);
+}
+#endif
+
+_UCXXEXPORT size_t __format_float(char * buffer, double f, ios_base::fmtflags flags, streamsize precision){
+	char * c = buffer;
+	bool uppercase = flags & ios_base::uppercase;
+
+	if(signbit(f)){
+		*c++ = '-';
+		f = -f;
+	}
+	if(isnan(f) || isinf(f)){
+		const char * text = isnan(f) ? (uppercase ? "NAN" : "nan") : (uppercase ? "INF" : "inf");
+		while(*text != 0){
+			*c++ = *text++;
+		}
+		return c - buffer;
+	}
+
+	//Keeps %e within the buffer: sign, digit, point, fraction, e-123
+	if(precision < 0){
+		precision = 6;
+	}
+	if(precision > static_cast<streamsize>(__float_chars) - 10){
+		precision = __float_chars - 10;
+	}
+
+	int exponent = 0;
+	if(f != 0){
+		double x = f;
+		while(x >= 10){
+			x /= 10;
+			++exponent;
+		}
+		while(x < 1){
+			x *= 10;
+			--exponent;
+		}
+	}
+
+	char digits[__float_chars];
+	int length;
+	int fraction = precision;
+	bool scientific = false;
+	bool strip = false;
+	ios_base::fmtflags floatfield = flags & ios_base::floatfield;
+
+	if(floatfield == ios_base::fixed){
+		//Falls back to %e when the integer part does not fit
+		int room = static_cast<int>(__float_chars) - 5 - (exponent > 0 ? exponent : 0);
+		if(room < 0){
+			scientific = true;
+			length = __scientific_digits(f, exponent, fraction, digits);
+		}else{
+			if(fraction > room){
+				fraction = room;
+			}
+			//No digits after the point beyond the significant ones
+			if(fraction > __float_significant - 1 - exponent){
+				fraction = __float_significant - 1 - exponent > 0 ? __float_significant - 1 - exponent : 0;
+			}
+			length = __float_digits(f, exponent, -fraction, digits);
+		}
+	}else if(floatfield == ios_base::scientific){
+		scientific = true;
+		length = __scientific_digits(f, exponent, fraction, digits);
+	}else{
+		//precision counts the significant digits, %e and %f round the
+		//same digits, so they are computed only once
+		int significant = precision == 0 ? 1 : precision;
+		if(significant > __float_significant){
+			significant = __float_significant;
+		}
+		fraction = significant - 1;
+		length = __scientific_digits(f, exponent, fraction, digits);
+		if(exponent < significant && exponent >= -4){
+			fraction = significant - 1 - exponent;
+		}else{
+			scientific = true;
+		}
+		strip = !(flags & ios_base::showpoint);
+	}
+
+	//The digits before the point, digits[integer] is the first one after it
+	int integer = scientific ? 1 : length - fraction;
+	if(integer <= 0){
+		*c++ = '0';
+	}
+	for(int i = 0; i < integer; ++i){
+		*c++ = digits[i];
+	}
+	if(fraction > 0 || (flags & ios_base::showpoint)){
+		*c++ = '.';
+		for(int i = integer; i < integer + fraction; ++i){
+			*c++ = (i < 0 || i >= length) ? '0' : digits[i];
+		}
+		if(strip){
+			while(c[-1] == '0'){
+				--c;
+			}
+			if(c[-1] == '.'){
+				--c;
+			}
+		}
+	}
+
+	if(scientific){
+		*c++ = uppercase ? 'E' : 'e';
+		if(exponent < 0){
+			*c++ = '-';
+			exponent = -exponent;
+		}else{
+			*c++ = '+';
+		}
+		if(exponent >= 100){
+			*c++ = '0' + exponent / 100;
+		}
+		*c++ = '0' + exponent / 10 % 10;
+		*c++ = '0' + exponent % 10;
+	}
+	return c - buffer;
 }
 
 }
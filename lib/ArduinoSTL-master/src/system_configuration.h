@@ -23,6 +23,11 @@
  */
 #undef __UCLIBCXX_HAS_WCHAR__
 #define __UCLIBCXX_IOSTREAM_BUFSIZE__ 32
+//Characters an output serial stream (cout) collects before it writes them to the port
+//in one call, 1 writes every character on its own:
+#ifndef __UCLIBCXX_SERIAL_BUFSIZE__
+#define __UCLIBCXX_SERIAL_BUFSIZE__ 32
+#endif
 #undef __UCLIBCXX_HAS_LFS__
 #undef __UCLIBCXX_SUPPORT_CDIR__
 #undef __UCLIBCXX_SUPPORT_COUT__
@@ -32,6 +37,37 @@
  */
 //#define __UCLIBCXX_STL_BUFFER_SIZE__ 32
 #define __UCLIBCXX_STL_BUFFER_SIZE__ 8
+//Upper limit of the temporary buffer of stable_sort:
+#ifndef __UCLIBCXX_STL_SORT_BUFFER_BYTES__
+#define __UCLIBCXX_STL_SORT_BUFFER_BYTES__ 256
+#endif
+//Growth of a full vector (and string) and of the block map of a deque: ADDITIVE adds
+//__UCLIBCXX_STL_BUFFER_SIZE__ elements (least RAM), GEOMETRIC grows by half the capacity
+//(amortized O(1) push_back):
+#define __UCLIBCXX_STL_GROWTH_ADDITIVE__ 0
+#define __UCLIBCXX_STL_GROWTH_GEOMETRIC__ 1
+#ifndef __UCLIBCXX_VECTOR_GROWTH__
+#define __UCLIBCXX_VECTOR_GROWTH__ __UCLIBCXX_STL_GROWTH_GEOMETRIC__
+#endif
+#ifndef __UCLIBCXX_DEQUE_GROWTH__
+#define __UCLIBCXX_DEQUE_GROWTH__ __UCLIBCXX_STL_GROWTH_GEOMETRIC__
+#endif
+//Bytes of a deque block, a block holds a power of two of elements and at least 4:
+#ifndef __UCLIBCXX_DEQUE_BLOCK_BYTES__
+#define __UCLIBCXX_DEQUE_BLOCK_BYTES__ 64
+#endif
+//Characters (including the terminating 0) stored inside of a string object before it
+//allocates on the heap:
+#ifndef __UCLIBCXX_STRING_SSO_SIZE__
+#define __UCLIBCXX_STRING_SSO_SIZE__ 15
+#endif
+//Bytes of a callable stored inside of an inplace_function: two pointers, e.g. an object
+//pointer and a function pointer.  A member function pointer alone takes two pointers:
+#ifndef __UCLIBCXX_INPLACE_FUNCTION_SIZE__
+#define __UCLIBCXX_INPLACE_FUNCTION_SIZE__ (2 * sizeof(void *))
+#endif
+//map, set, multimap and multiset in a sorted vector instead of a red-black tree:
+//#define __UCLIBCXX_STL_FLAT_ASSOCIATIVE__
 #undef __UCLIBCXX_CODE_EXPANSION__
 
 /*
@@ -1,30 +1,28 @@
 #include "cycle_step.h"
 #include <ArduinoSTL.h>
 
-Cycle_step::Cycle_step() { //
-  object_count++;
-}
+// LIFECYCLE -------------------------------------------------------------------
 
-void Cycle_step::do_stuff() {
-  if (!_innit_completed) {
-    do_initial_stuff();
-    _innit_completed = true;
-  } else {
-    do_loop_stuff();
-  }
+Cycle_step_flags::Cycle_step_flags() {
+  _loop_completed = false;
+  _innit_completed = false;
 }
 
-void Cycle_step::reset_flags() {
+bool Cycle_step_flags::innit_is_completed() { return _innit_completed; }
+
+void Cycle_step_flags::set_innit_completed() { _innit_completed = true; }
+
+void Cycle_step_flags::reset_flags() {
   _innit_completed = false;
   _loop_completed = false;
 }
 
-void Cycle_step::set_loop_completed() { //
+void Cycle_step_flags::set_loop_completed() { //
   _loop_completed = true;
 }
 
 // This is a "one time flag", state will be reseted after fist inquiry:
-bool Cycle_step::is_completed() {
+bool Cycle_step_flags::is_completed() {
   if (_loop_completed) {
     _loop_completed = false;
     _innit_completed = false;
@@ -33,3 +31,20 @@ bool Cycle_step::is_completed() {
     return false;
   }
 }
+
+// STEP WITH VIRTUAL FUNCTIONS -------------------------------------------------
+
+int Cycle_step::object_count = 0; // enable object counting
+
+Cycle_step::Cycle_step() { //
+  object_count++;
+}
+
+void Cycle_step::do_stuff() {
+  if (!innit_is_completed()) {
+    do_initial_stuff();
+    set_innit_completed();
+  } else {
+    do_loop_stuff();
+  }
+}
@@ -2,7 +2,35 @@
 #define CYCLESTEP_H
 #include <ArduinoSTL.h>
 
-class Cycle_step {
+// LIFECYCLE OF A STEP (SHARED BY BOTH KINDS OF STEPS) *************************
+// init once, loop until set_loop_completed(), is_completed() is a one shot
+
+class Cycle_step_flags {
+public:
+  // FUNCTIONS:
+  Cycle_step_flags();
+  void reset_flags();
+
+  // SETTER:
+  void set_loop_completed();
+
+  // GETTER:
+  bool is_completed();
+
+protected:
+  // FUNCTIONS:
+  bool innit_is_completed();
+  void set_innit_completed();
+
+private:
+  // VARIABLES:
+  bool _loop_completed;
+  bool _innit_completed;
+};
+
+// STEP WITH VIRTUAL FUNCTIONS *************************************************
+
+class Cycle_step : public Cycle_step_flags {
 public:
   // VARIABLES:
   static int object_count;
@@ -10,26 +38,94 @@ public:
   // FUNCTIONS:
   Cycle_step();
   void do_stuff();
-  void reset_flags();
 
   // VIRTUAL FUNCTIONS:
   virtual void do_initial_stuff() = 0;
   virtual void do_loop_stuff() = 0;
 
-  // SETTER:
-  void set_loop_completed();
-
   // GETTER:
-  bool is_completed();
   virtual String get_display_text() = 0;
+};
+
+// STEP WITH STATIC DISPATCH ***************************************************
+// class Cut_strap : public Static_cycle_step<Cut_strap> { ... };
+// Cut_strap has public do_initial_stuff() and do_loop_stuff(), no vtable.
+// The display text comes from the PROGMEM table of its Cycle_sequence.
+
+template <class Step> class Static_cycle_step : public Cycle_step_flags {
+public:
+  void do_stuff() {
+    if (!innit_is_completed()) {
+      static_cast<Step *>(this)->do_initial_stuff();
+      set_innit_completed();
+    } else {
+      static_cast<Step *>(this)->do_loop_stuff();
+    }
+  }
+};
+
+// The steps of a sequence, stored one after the other. do_stuff(n) is a
+// chain of compares that ends in an inlined call of step n:
+template <class... Steps> class Cycle_step_chain {
+public:
+  void do_stuff(byte) {}
+  Cycle_step_flags *get_flags(byte) { return NULL; }
+};
+
+template <class First, class... Rest> class Cycle_step_chain<First, Rest...> {
+public:
+  void do_stuff(byte step) {
+    if (step == 0) {
+      _first.do_stuff();
+    } else {
+      _rest.do_stuff(step - 1);
+    }
+  }
+  Cycle_step_flags *get_flags(byte step) {
+    return step == 0 ? &_first : _rest.get_flags(step - 1);
+  }
 
 private:
-  // VARIABLES:
-  bool _loop_completed;
-  bool _innit_completed;
+  First _first;
+  Cycle_step_chain<Rest...> _rest;
+};
 
+// SEQUENCE OF STEPS WITH STATIC DISPATCH **************************************
+// display_names: PROGMEM table of PROGMEM strings, one per step in the order
+// of Steps. No step is allocated on the heap and no String gets created.
+
+template <class... Steps> class Cycle_sequence {
+public:
   // FUNCTIONS:
-  //n.A.
+  explicit Cycle_sequence(const char *const *display_names) : _display_names(display_names) {}
+  static constexpr byte size() { return sizeof...(Steps); }
+
+  void do_stuff(byte step) { _steps.do_stuff(step); }
+  void reset_flags(byte step) {
+    Cycle_step_flags *flags = _steps.get_flags(step);
+    if (flags) {
+      flags->reset_flags();
+    }
+  }
+
+  // GETTER:
+  bool is_completed(byte step) {
+    Cycle_step_flags *flags = _steps.get_flags(step);
+    return flags && flags->is_completed();
+  }
+  // Copies the display text of the step from flash into the buffer:
+  void get_display_text(byte step, char *buffer, byte buffer_size) const {
+    buffer[0] = '\0';
+    if (step < size()) {
+      strncpy_P(buffer, (const char *)pgm_read_word(&_display_names[step]), buffer_size - 1);
+      buffer[buffer_size - 1] = '\0';
+    }
+  }
+
+private:
+  // VARIABLES:
+  Cycle_step_chain<Steps...> _steps;
+  const char *const *_display_names;
 };
 
 #endif
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * display_shadow.cpp **********************************************************
+ *******************************************************************************/
+
+#include "display_shadow.h"
+
+// NEXTION COMMAND BUFFER ******************************************************
+
+Nextion_command::Nextion_command() {
+  _length = 0;
+  _overflow = false;
+}
+
+void Nextion_command::add_byte(uint8_t value) {
+  if (_length < max_length) {
+    _buffer[_length++] = value;
+  } else {
+    _overflow = true;
+  }
+}
+
+void Nextion_command::add(const char *text) {
+  while (*text) {
+    add_byte(*text++);
+  }
+}
+
+void Nextion_command::add(long value) {
+  char digits[12];
+  ltoa(value, digits, 10);
+  add(digits);
+}
+
+void Nextion_command::end_command() {
+  for (byte i = 0; i < 3; i++) {
+    add_byte(0xff);
+  }
+}
+
+const uint8_t *Nextion_command::get_buffer() { return _buffer; }
+
+byte Nextion_command::get_length() { return _length; }
+
+bool Nextion_command::is_complete() { return !_overflow; }
+
+// SHADOW OF A PAGE ************************************************************
+
+void Display_shadow::setup(const Shadow_component *components, byte number_of_components,
+                           byte byte_budget) {
+  _components = components;
+  _number_of_components = number_of_components;
+  _byte_budget = byte_budget;
+  _known_values = 0;
+  _no_of_refused_commands = 0;
+}
+
+void Display_shadow::invalidate() { _known_values = 0; }
+
+void Display_shadow::invalidate(byte component_number) {
+  _known_values &= ~(uint16_t(1) << component_number);
+}
+
+bool Display_shadow::value_is_on_display(byte component_number, long value) {
+  bool value_is_known = _known_values & (uint16_t(1) << component_number);
+  return value_is_known && _sent_values[component_number] == value;
+}
+
+void Display_shadow::mark_as_sent(byte component_number, long value) {
+  _sent_values[component_number] = value;
+  _known_values |= (uint16_t(1) << component_number);
+}
+
+void Display_shadow::push_changes(HardwareSerial &serial) {
+  // Never write more than fits into the transmit buffer, writing would block:
+  int free_space = serial.availableForWrite();
+  int written = 0;
+
+  for (byte i = 0; i < _number_of_components; i++) {
+    long value = _components[i].get_value();
+    if (value_is_on_display(i, value)) {
+      continue;
+    }
+
+    Nextion_command command;
+    _components[i].render(_components[i].name, value, command);
+
+    // A cut off command would desync the display, it is not sent and not retried
+    // until the value changes again:
+    if (!command.is_complete()) {
+      _no_of_refused_commands++;
+      mark_as_sent(i, value);
+      continue;
+    }
+
+    // Stop at the first change that does not fit, lower priorities must not overtake.
+    // A command longer than the whole budget goes alone, once the transmit buffer
+    // can take it (max_length always fits into an empty transmit buffer):
+    int length = command.get_length();
+    bool is_within_budget = written + length <= _byte_budget || written == 0;
+    if (!is_within_budget || written + length > free_space) {
+      return;
+    }
+
+    serial.write(command.get_buffer(), length);
+    written += length;
+    mark_as_sent(i, value);
+  }
+}
+
+unsigned int Display_shadow::get_no_of_refused_commands() { return _no_of_refused_commands; }
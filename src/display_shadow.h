@@ -0,0 +1,103 @@
+/* *****************************************************************************
+ * display_shadow.h ************************************************************
+ * *****************************************************************************
+ * SHADOW MODEL OF A NEXTION PAGE:
+ *
+ * Holds the last value that has been sent to every component of a page.
+ * Every loop the current machine state is compared against the shadow and
+ * only the changed components are sent to the display:
+ *
+ * • in the order of the component list (= visual priority, highest first)
+ * • never more bytes per loop than the byte budget allows
+ * • never more bytes than the transmit buffer can take, Serial.write() would block
+ *
+ * After a page change the shadow gets invalidated. The page is then repainted
+ * incrementally over the next few loops instead of in one blocking burst.
+ *
+ * A command that does not fit into the Nextion_command buffer is refused, a cut
+ * off command would lose its 0xff 0xff 0xff and desync the display.
+ * *****************************************************************************
+ */
+
+#ifndef DISPLAY_SHADOW_H_
+#define DISPLAY_SHADOW_H_
+
+#include "Arduino.h"
+
+// NEXTION COMMAND BUFFER ******************************************************
+
+class Nextion_command {
+
+public:
+  // FUNCTIONS:
+  Nextion_command();
+
+  void add(const char *text);
+  void add(long value);
+  void end_command(); // terminates a command with 0xff 0xff 0xff
+
+  // GETTER:
+  const uint8_t *get_buffer();
+  byte get_length();
+  bool is_complete(); // false if anything did not fit into the buffer
+
+  // The longest command an empty transmit buffer takes without blocking (63 bytes
+  // on the Mega). The longest of main.cpp is the traffic light with 37 bytes:
+  // b8.bco=63488 ff ff ff b8.txt="CRIMPEN" ff ff ff
+  static const byte max_length = SERIAL_TX_BUFFER_SIZE - 1;
+
+private:
+  // FUNCTIONS:
+  void add_byte(uint8_t value);
+
+  // VARIABLES:
+  uint8_t _buffer[max_length];
+  byte _length;
+  bool _overflow;
+};
+
+// COMPONENT OF A PAGE *********************************************************
+
+struct Shadow_component {
+  const char *name; // nextion object name, e.g. "bt1"
+  long (*get_value)(); // current machine state of the component
+  void (*render)(const char *name, long value, Nextion_command &command);
+};
+
+// SHADOW OF A PAGE ************************************************************
+
+class Display_shadow {
+
+public:
+  // FUNCTIONS:
+  template <size_t number_of_components>
+  Display_shadow(const Shadow_component (&components)[number_of_components], byte byte_budget) {
+    static_assert(number_of_components <= _max_components,
+                  "one bit of _known_values per component, split the page");
+    setup(components, number_of_components, byte_budget);
+  }
+
+  void invalidate(); // all components have to be sent again
+  void invalidate(byte component_number);
+  void push_changes(HardwareSerial &serial);
+
+  // GETTER:
+  unsigned int get_no_of_refused_commands();
+
+private:
+  // FUNCTIONS:
+  void setup(const Shadow_component *components, byte number_of_components, byte byte_budget);
+  bool value_is_on_display(byte component_number, long value);
+  void mark_as_sent(byte component_number, long value);
+
+  // VARIABLES:
+  static const byte _max_components = 16;
+  const Shadow_component *_components;
+  byte _number_of_components;
+  byte _byte_budget;
+  uint16_t _known_values; // bit n is set if _sent_values[n] is shown on the display
+  long _sent_values[_max_components];
+  unsigned int _no_of_refused_commands;
+};
+
+#endif
@@ -22,42 +22,32 @@
 #include <Debounce.h> //            https://github.com/chischte/debounce-library
 #include <EEPROM_Counter.h> //      https://github.com/chischte/eeprom-counter-library
 #include <Insomnia.h> //            https://github.com/chischte/insomnia-delay-library
-#include <Nextion.h> //             PIO Nextion library
 #include <SD.h> //                  PIO Adafruit SD library
 #include <alias_colino.h> //        aliases when using an Arduino instead of a Controllino
 #include <cycle_step.h> //          blueprint of a cycle step
+#include <display_shadow.h> //      keeps track of the values shown on the display
+#include <memory_monitor.h> //      watches heap, stack and free ram
+#include <nextion_receiver.h> //    receives the touch events of the display
 #include <state_controller.h> //    keeps track of machine states
+#include <telemetry.h> //           binary data stream to the host
 #include <traffic_light.h> //       keeps track of user infos, manages text and colors
 
 // DECLARE FUNCTIONS IF NEEDED FOR THE COMPILER: *******************************
 
-void clear_text_field(String textField);
+void clear_info_field();
 void hide_info_field();
-void page_0_push(void *ptr);
-void page_1_push(void *ptr);
-void page_2_push(void *ptr);
-void display_loop_page_1_left_side();
-void display_loop_page_1_right_side();
-void display_loop_page_2_left_side();
-void display_loop_page_2_right_side();
-void display_text_in_info_field(String text);
-void update_traffic_light_field();
-void set_traffic_light_field_text(String text);
-void set_traffic_light_field_color(String color);
-void update_cycle_name();
-void update_upper_slider_value();
-void update_lower_slider_value();
-void update_upper_counter_value();
-void update_switches_page_2_left();
-void update_lower_counter_value();
+void page_1_push();
+void page_2_push();
+void page_3_push();
+void display_force_label_in_info_field();
 void reset_lower_counter_value();
 void increase_slider_value(int eeprom_value_number);
 void decrease_slider_value(int eeprom_value_number);
-void update_field_values_page_2();
 void show_info_field();
-String get_main_cycle_display_string();
-String get_continuous_cycle_display_string();
-String add_suffix_to_eeprom_value(int eeprom_value_number, String suffix);
+void get_cycle_display_text(char *buffer, byte buffer_size);
+void reset_flag_of_current_step();
+
+const byte cycle_display_text_size = 20; // longest step text + terminating zero
 
 // DEFINE NAMES FOR THE CYCLE COUNTER ******************************************
 
@@ -75,10 +65,9 @@ const byte micro_step_factor = 2;
 const long full_steps_per_mm = 80; // calculated from measurements
 const byte stepper_direction_factor = 1; // set -1 to change direction
 
-const byte UPPER_MOTOR_STEP_PIN = CONTROLLINO_D0;
+// The drivers generate the step pulses with their oscillator, motor_upper_pulse and
+// motor_lower_pulse switch it on and off. Only the directions are set here:
 const byte UPPER_MOTOR_DIRECTION_PIN = CONTROLLINO_D1;
-
-const byte LOWER_MOTOR_STEP_PIN = CONTROLLINO_D3;
 const byte LOWER_MOTOR_DIRECTION_PIN = CONTROLLINO_D4;
 
 const byte PRESSURE_SENSOR_PIN = CONTROLLINO_A2;
@@ -88,6 +77,8 @@ const byte PRESSURE_SENSOR_PIN = CONTROLLINO_A2;
 EEPROM_Counter counter;
 State_controller state_controller;
 Traffic_light traffic_light;
+Telemetry telemetry(Serial);
+Memory_monitor memory_monitor(256); // [bytes] alarm below this stack headroom
 
 Cylinder cylinder_sledge_inlet(CONTROLLINO_D14);
 Cylinder cylinder_sledge_vent(CONTROLLINO_D13);
@@ -109,6 +100,8 @@ Insomnia motor_output_timeout(259200000); // = 3 days// planned to prevent overh
 Insomnia motor_display_sleep_timeout(259000000); // to inform that brakes will soon release
 Insomnia nex_reset_button_timeout(3000); // pushtime to reset counter
 Insomnia print_interval_timeout(1000);
+Insomnia telemetry_counter_timeout(100);
+Insomnia telemetry_memory_timeout(1000);
 Insomnia erase_force_value_timeout(5000);
 Insomnia pressure_update_delay;
 Insomnia cycle_step_delay;
@@ -118,74 +111,52 @@ Insomnia lower_feed_delay;
 // NEXTION DISPLAY OBJECTS *****************************************************
 
 // PAGE 0 ----------------------------------------------------------------------
-NexPage nex_page_0 = NexPage(0, 0, "page0");
+const Nextion_object nex_page_0 = {0, 0, "page0"};
 // PAGE 1 - LEFT SIDE ----------------------------------------------------------
-NexPage nex_page_1 = NexPage(1, 0, "page1");
-NexButton button_previous_step = NexButton(1, 6, "b1");
-NexButton button_next_step = NexButton(1, 7, "b2");
-NexButton button_reset_cycle = NexButton(1, 5, "b0");
-NexButton button_traffic_light = NexButton(1, 15, "b8");
-NexDSButton switch_step_auto_mode = NexDSButton(1, 4, "bt1");
+const Nextion_object nex_page_1 = {1, 0, "page1"};
+const Nextion_object button_previous_step = {1, 6, "b1"};
+const Nextion_object button_next_step = {1, 7, "b2"};
+const Nextion_object button_reset_cycle = {1, 5, "b0"};
+const Nextion_object button_traffic_light = {1, 15, "b8"};
+const Nextion_object switch_step_auto_mode = {1, 4, "bt1"};
 // PAGE 1 - RIGHT SIDE ---------------------------------------------------------
-NexButton button_upper_motor = NexButton(1, 9, "b4");
-NexButton button_lower_motor = NexButton(1, 8, "b3");
-NexButton button_cut = NexButton(1, 14, "b5");
-NexButton button_sledge = NexButton(1, 1, "b6");
-NexDSButton switch_motor_brake = NexDSButton(1, 10, "bt5");
-NexDSButton switch_air_release = NexDSButton(1, 13, "bt3");
+const Nextion_object button_upper_motor = {1, 9, "b4"};
+const Nextion_object button_lower_motor = {1, 8, "b3"};
+const Nextion_object button_cut = {1, 14, "b5"};
+const Nextion_object button_sledge = {1, 1, "b6"};
+const Nextion_object switch_motor_brake = {1, 10, "bt5"};
+const Nextion_object switch_air_release = {1, 13, "bt3"};
 // PAGE 2 - LEFT SIDE ----------------------------------------------------------
-NexPage nex_page_2 = NexPage(2, 0, "page2");
-NexButton button_slider_1_left = NexButton(2, 5, "b1");
-NexButton button_slider_1_right = NexButton(2, 6, "b2");
-NexButton button_slider_2_left = NexButton(2, 16, "b5");
-NexButton button_slider_2_right = NexButton(2, 17, "b6");
-NexDSButton switch_continuous_mode = NexDSButton(2, 18, "bt3");
+const Nextion_object nex_page_2 = {2, 0, "page2"};
+const Nextion_object button_slider_1_left = {2, 5, "b1"};
+const Nextion_object button_slider_1_right = {2, 6, "b2"};
+const Nextion_object button_slider_2_left = {2, 16, "b5"};
+const Nextion_object button_slider_2_right = {2, 17, "b6"};
+const Nextion_object switch_continuous_mode = {2, 18, "bt3"};
 
 // PAGE 2 - RIGHT SIDE ---------------------------------------------------------
-NexButton button_reset_shorttime_counter = NexButton(2, 12, "b4");
-
-// NEXTION DISPLAY - TOUCH EVENT LIST ******************************************
-
-NexTouch *nex_listen_list[] = { //
-    // PAGE 0:
-    &nex_page_0,
-    // PAGE 1 LEFT:
-    &nex_page_1, &button_previous_step, &button_next_step, &button_reset_cycle,
-    &button_traffic_light, &switch_step_auto_mode,
-    // PAGE 1 RIGHT:
-    &button_cut, &switch_motor_brake, &switch_air_release, &button_sledge, &button_upper_motor,
-    &button_lower_motor,
-    // PAGE 2 LEFT:
-    &nex_page_2, &button_slider_1_left, &button_slider_1_right, &nex_page_2, &button_slider_2_left,
-    &button_slider_2_right, &switch_continuous_mode,
-    // PAGE 2 RIGHT:
-    &button_reset_shorttime_counter,
-    // END OF LISTEN LIST:
-    NULL};
+const Nextion_object button_reset_shorttime_counter = {2, 12, "b4"};
+// PAGE 3 - DIAGNOSTICS --------------------------------------------------------
+const Nextion_object nex_page_3 = {3, 0, "page3"};
+
+// NEXTION DISPLAY - TOUCH EVENT RECEIVER **************************************
+
+Nextion_receiver nextion_receiver;
 
 // VARIABLES TO MONITOR NEXTION DISPLAY STATES *********************************
 
-bool nex_state_air_release;
-bool nex_state_upper_motor;
-bool nex_state_lower_motor;
-bool nex_state_motor_brake;
-bool nex_state_sledge;
-bool nex_state_blade;
-bool nex_state_machine_running;
-bool nex_state_step_mode = true;
-bool nex_state_continuous_mode;
-byte nex_prev_cycle_step;
 byte nex_current_page = 0;
-long nex_upper_strap_feed;
-long nex_lower_strap_feed;
-long nex_shorttime_counter;
-long nex_longtime_counter;
 
-// CREATE VECTOR CONTAINER FOR THE CYCLE STEPS OBJECTS ************************
-
-int Cycle_step::object_count = 0; // enable object counting
-std::vector<Cycle_step *> main_cycle_steps;
-std::vector<Cycle_step *> continuous_cycle_steps;
+// INFO FIELD t4 OF PAGE 1 (SENT BY THE DISPLAY SHADOW OF PAGE 1):
+enum info_field_content {
+  info_field_empty, //
+  info_field_force_label, //
+  info_field_force // [N]
+};
+bool info_field_is_visible = false;
+info_field_content info_field_text = info_field_empty;
+int info_field_force_value = 0;
+const byte nex_byte_budget_per_loop = 32; // [bytes] must be smaller than the TX buffer
 
 // NON NEXTION FUNCTIONS *******************************************************
 
@@ -200,26 +171,27 @@ void set_initial_cylinder_states() {
   motor_lower_pulse.set(0);
 }
 
-void reset_flag_of_current_step() {
-
-  if (state_controller.is_in_auto_mode() || state_controller.is_in_step_mode()) {
-    main_cycle_steps[state_controller.get_current_step()]->reset_flags();
-  }
-  if (state_controller.is_in_continuous_mode()) {
-    continuous_cycle_steps[state_controller.get_current_step()]->reset_flags();
-  }
-}
-
 void stop_machine() {
   set_initial_cylinder_states();
   state_controller.set_step_mode();
   state_controller.set_machine_stop();
 }
 
+void monitor_memory() {
+  static bool machine_has_been_stopped = false;
+  memory_monitor.update();
+
+  // STOP ONCE, BEFORE HEAP AND STACK COLLIDE:
+  if (memory_monitor.alarm_is_active() && !machine_has_been_stopped) {
+    stop_machine();
+    machine_has_been_stopped = true;
+  }
+}
+
 void reset_machine() {
   state_controller.set_machine_stop();
   set_initial_cylinder_states();
-  clear_text_field("t4");
+  clear_info_field();
   hide_info_field();
   state_controller.set_step_mode();
   state_controller.set_current_step_to(0);
@@ -324,9 +296,8 @@ void vent_sledge() {
 void display_force(int force) {
   if (nex_current_page == 1) {
     show_info_field();
-    String force_string = String(force);
-    String suffix = " N";
-    display_text_in_info_field(force_string + suffix);
+    info_field_text = info_field_force;
+    info_field_force_value = force;
   }
 }
 
@@ -384,164 +355,268 @@ void measure_and_display_current_force() {
 
 // NEXTION GENERAL DISPLAY FUNCTIONS *******************************************
 
+// Blocking, for the display setup only. loop() sends through the display shadow:
 void send_to_nextion() {
   Serial2.write(0xff);
   Serial2.write(0xff);
   Serial2.write(0xff);
 }
 
-void update_display_counter() {
-  long new_value = counter.get_value(longtime_counter);
-  Serial2.print("t0.txt=");
-  Serial2.print("\"");
-  Serial2.print(new_value);
-  Serial2.print("\"");
-  send_to_nextion();
-}
+// Only the state of the info field gets set, the shadow sends it:
+void show_info_field() { info_field_is_visible = true; }
 
-void show_info_field() {
-  if (nex_current_page == 1) {
-    Serial2.print("vis t4,1");
-    send_to_nextion();
-  }
-}
+void hide_info_field() { info_field_is_visible = false; }
 
-void display_text_in_info_field(String text) {
-  Serial2.print("t4");
-  Serial2.print(".txt=");
-  Serial2.print("\"");
-  Serial2.print(text);
-  Serial2.print("\"");
-  send_to_nextion();
-}
+void clear_info_field() { info_field_text = info_field_empty; }
 
-void hide_info_field() {
-  if (nex_current_page == 1) {
-    Serial2.print("vis t4,0");
-    send_to_nextion();
-  }
-}
+void display_force_label_in_info_field() { info_field_text = info_field_force_label; }
 
-void clear_text_field(String textField) {
-  Serial2.print(textField);
-  Serial2.print(".txt=");
-  Serial2.print("\"");
-  Serial2.print(""); // erase text
-  Serial2.print("\"");
-  send_to_nextion();
-}
+// NEXTION DISPLAY SHADOW ******************************************************
 
-void display_value_in_field(int value, String valueField) {
-  Serial2.print(valueField);
-  Serial2.print(".val=");
-  Serial2.print(value);
-  send_to_nextion();
-}
+// RENDER FUNCTIONS ------------------------------------------------------------
 
-void display_text_in_field(String text, String textField) {
-  Serial2.print(textField);
-  Serial2.print(".txt=");
-  Serial2.print("\"");
-  Serial2.print(text);
-  Serial2.print("\"");
-  send_to_nextion();
-}
+void render_ds_switch(const char *name, long state, Nextion_command &command) {
+  command.add(name);
+  command.add(".val=");
+  command.add(state);
+  command.end_command();
+}
+
+void render_momentary_button(const char *name, long state, Nextion_command &command) {
+  command.add("click ");
+  command.add(name);
+  command.add(",");
+  command.add(state);
+  command.end_command();
+}
+
+void render_visibility(const char *name, long visible, Nextion_command &command) {
+  command.add("vis ");
+  command.add(name);
+  command.add(",");
+  command.add(visible);
+  command.end_command();
+}
+
+void render_info_field(const char *name, long content, Nextion_command &command) {
+  command.add(name);
+  command.add(".txt=\"");
+  if (info_field_text == info_field_force_label) {
+    command.add("ZUGKRAFT");
+  }
+  if (info_field_text == info_field_force) {
+    command.add(long(info_field_force_value));
+    command.add(" N");
+  }
+  command.add("\"");
+  command.end_command();
+}
+
+void render_text_value(const char *name, long value, Nextion_command &command) {
+  command.add(name);
+  command.add(".txt=\"");
+  command.add(value);
+  command.add("\"");
+  command.end_command();
+}
+
+void render_mm_value(const char *name, long value, Nextion_command &command) {
+  command.add(name);
+  command.add(".txt=\"");
+  command.add(value);
+  command.add(" mm\"");
+  command.end_command();
+}
+
+void render_traffic_light(const char *name, long info, Nextion_command &command) {
+  command.add(name);
+  command.add(".bco=");
+  command.add(traffic_light.get_info_color().c_str());
+  command.end_command();
+  command.add(name);
+  command.add(".txt=\"");
+  command.add(traffic_light.get_info_text().c_str());
+  command.add("\"");
+  command.end_command();
+}
+
+void render_cycle_name(const char *name, long value, Nextion_command &command) {
+  command.add(name);
+  command.add(".txt=\"");
+  command.add(long(state_controller.get_current_step() + 1));
+  command.add(" ");
+  char display_text[cycle_display_text_size];
+  get_cycle_display_text(display_text, sizeof(display_text));
+  command.add(display_text);
+  command.add("\"");
+  command.end_command();
+}
+
+// MACHINE STATES SHOWN ON THE DISPLAY -----------------------------------------
+
+long get_traffic_light_info() { return traffic_light.get_info(); }
+long get_cycle_name_value() {
+  // Offset to tell continuous steps apart from main cycle steps with the same number:
+  long continuous_offset = state_controller.is_in_continuous_mode() ? 1000 : 0;
+  return state_controller.get_current_step() + continuous_offset;
+}
+long get_info_field_visibility() { return info_field_is_visible; }
+long get_info_field_content() {
+  return (long(info_field_text) << 16) | uint16_t(info_field_force_value);
+}
+long get_step_mode_state() { return state_controller.is_in_step_mode(); }
+long get_motor_brake_state() { return motor_upper_enable.get_state(); }
+long get_air_release_state() { return cylinder_sledge_vent.get_state(); }
+long get_sledge_state() { return cylinder_sledge_inlet.get_state(); }
+long get_upper_motor_state() { return motor_upper_pulse.get_state(); }
+long get_blade_state() { return cylinder_blade.get_state(); }
+long get_lower_motor_state() { return motor_lower_pulse.get_state(); }
+long get_continuous_mode_state() { return state_controller.is_in_continuous_mode(); }
+long get_upper_strap_feed() { return counter.get_value(upper_strap_feed); }
+long get_lower_strap_feed() { return counter.get_value(lower_strap_feed); }
+long get_shorttime_counter() { return counter.get_value(shorttime_counter); }
+long get_longtime_counter() { return counter.get_value(longtime_counter); }
+long get_free_ram() { return memory_monitor.get_free_ram(); }
+long get_min_stack_headroom() { return memory_monitor.get_min_stack_headroom(); }
+long get_heap_free() { return memory_monitor.get_heap_free(); }
+long get_largest_free_block() { return memory_monitor.get_largest_free_block(); }
+long get_heap_end() { return memory_monitor.get_brkval(); }
+long get_pool_exhaustions() { return memory_monitor.get_no_of_pool_exhaustions(); }
+
+// PAGE 1 COMPONENTS (ORDER = VISUAL PRIORITY) ---------------------------------
+
+enum page_1_component {
+  page_1_traffic_light, //
+  page_1_cycle_name, //
+  page_1_info_field_text, //
+  page_1_info_field_visibility, //
+  page_1_step_mode, //
+  page_1_motor_brake, //
+  page_1_air_release, //
+  page_1_sledge, //
+  page_1_upper_motor, //
+  page_1_blade, //
+  page_1_lower_motor, //
+  end_of_page_1_enum // keep this entry
+};
 
-void toggle_ds_switch(String button) {
-  Serial2.print("click " + button + ",1");
-  send_to_nextion();
-}
+const Shadow_component page_1_components[end_of_page_1_enum] = {
+    {"b8", get_traffic_light_info, render_traffic_light},
+    {"t0", get_cycle_name_value, render_cycle_name},
+    {"t4", get_info_field_content, render_info_field},
+    {"t4", get_info_field_visibility, render_visibility},
+    {"bt1", get_step_mode_state, render_ds_switch},
+    {"bt5", get_motor_brake_state, render_ds_switch},
+    {"bt3", get_air_release_state, render_ds_switch},
+    {"b6", get_sledge_state, render_momentary_button},
+    {"b4", get_upper_motor_state, render_momentary_button},
+    {"b5", get_blade_state, render_momentary_button},
+    {"b3", get_lower_motor_state, render_momentary_button}};
+
+// PAGE 2 COMPONENTS (ORDER = VISUAL PRIORITY) ---------------------------------
+
+enum page_2_component {
+  page_2_continuous_mode, //
+  page_2_upper_strap_feed, //
+  page_2_lower_strap_feed, //
+  page_2_shorttime_counter, //
+  page_2_longtime_counter, //
+  end_of_page_2_enum // keep this entry
+};
 
-void set_momentary_button_high_or_low(String button, bool state) {
-  Serial2.print("click " + button + "," + state);
-  send_to_nextion();
-}
+const Shadow_component page_2_components[end_of_page_2_enum] = {
+    {"bt3", get_continuous_mode_state, render_ds_switch},
+    {"t4", get_upper_strap_feed, render_mm_value},
+    {"t2", get_lower_strap_feed, render_mm_value},
+    {"t12", get_shorttime_counter, render_text_value},
+    {"t10", get_longtime_counter, render_text_value}};
+
+// PAGE 3 COMPONENTS (ORDER = VISUAL PRIORITY) ---------------------------------
+
+enum page_3_component {
+  page_3_min_stack_headroom, //
+  page_3_free_ram, //
+  page_3_heap_free, //
+  page_3_largest_free_block, //
+  page_3_heap_end, //
+  page_3_pool_exhaustions, //
+  end_of_page_3_enum // keep this entry
+};
+
+const Shadow_component page_3_components[end_of_page_3_enum] = {
+    {"t1", get_min_stack_headroom, render_text_value},
+    {"t0", get_free_ram, render_text_value},
+    {"t2", get_heap_free, render_text_value},
+    {"t3", get_largest_free_block, render_text_value},
+    {"t4", get_heap_end, render_text_value},
+    {"t5", get_pool_exhaustions, render_text_value}};
+
+Display_shadow shadow_page_1(page_1_components, nex_byte_budget_per_loop);
+Display_shadow shadow_page_2(page_2_components, nex_byte_budget_per_loop);
+Display_shadow shadow_page_3(page_3_components, nex_byte_budget_per_loop);
 
 // NEXTION TOUCH EVENT FUNCTIONS ***********************************************
 
 // TOUCH EVENT FUNCTIONS PAGE 1 - LEFT SIDE ------------------------------------
 
-void button_traffic_light_push(void *ptr) {
+void button_traffic_light_push() {
 
   if (traffic_light.is_in_start_state()) {
     state_controller.set_machine_running();
-    nex_state_machine_running = !nex_state_machine_running;
   }
   if (traffic_light.is_in_sleep_state()) {
     motor_output_enable(); // wakes the tool up
   }
 }
 
-void switch_step_auto_mode_push(void *ptr) {
+void switch_step_auto_mode_push() {
   state_controller.toggle_step_auto_mode();
-  nex_state_step_mode = state_controller.is_in_step_mode();
+  shadow_page_1.invalidate(page_1_step_mode); // the switch has been toggled by the touch
 }
 
-void button_stepback_push(void *ptr) {
+void button_stepback_push() {
   state_controller.set_machine_stop();
   reset_flag_of_current_step();
   state_controller.switch_to_previous_step();
   reset_flag_of_current_step();
 }
 
-void button_next_step_push(void *ptr) {
+void button_next_step_push() {
   state_controller.set_machine_stop();
   reset_flag_of_current_step();
   state_controller.switch_to_next_step();
   reset_flag_of_current_step();
 }
 
-void button_reset_cycle_push(void *ptr) {
+void button_reset_cycle_push() {
   reset_flag_of_current_step();
   set_initial_cylinder_states();
   state_controller.set_reset_mode(true);
-  clear_text_field("t4");
+  clear_info_field();
   hide_info_field();
 }
 
 // TOUCH EVENT FUNCTIONS PAGE 1 - RIGHT SIDE -----------------------------------
 
-void switch_motor_brake_push(void *ptr) {
+void switch_motor_brake_push() {
   motor_output_toggle();
-  nex_state_motor_brake = !nex_state_motor_brake;
-}
-void button_motor_oben_push(void *ptr) { //
-  start_upper_motor();
-}
-void button_motor_oben_pop(void *ptr) { //
-  stop_upper_motor();
-}
-void button_motor_unten_push(void *ptr) { //
-  start_lower_motor();
-}
-void button_motor_unten_pop(void *ptr) { //
-  stop_lower_motor();
+  shadow_page_1.invalidate(page_1_motor_brake);
 }
-void switch_air_release_push(void *ptr) {
+void switch_air_release_push() {
   cylinder_sledge_vent.toggle();
-  nex_state_air_release = !nex_state_air_release;
+  shadow_page_1.invalidate(page_1_air_release);
 }
-void button_schneiden_push(void *ptr) {
+void button_schneiden_push() {
   cylinder_blade.set(1);
   cylinder_frontclap.set(1);
 }
-void button_schneiden_pop(void *ptr) {
+void button_schneiden_pop() {
   cylinder_blade.set(0);
   cylinder_frontclap.set(0);
 }
-void button_schlitten_push(void *ptr) { //
-  cylinder_sledge_inlet.set(1);
-}
-void button_schlitten_pop(void *ptr) { //
-  cylinder_sledge_inlet.set(0);
-}
 
 // TOUCH EVENT FUNCTIONS PAGE 2 - LEFT SIDE ------------------------------------
 
-void button_upper_slider_left_push(void *ptr) { decrease_slider_value(upper_strap_feed); }
-void button_upper_slider_right_push(void *ptr) { increase_slider_value(upper_strap_feed); }
-void button_lower_slider_left_push(void *ptr) { decrease_slider_value(lower_strap_feed); }
-void button_lower_slider_right_push(void *ptr) { increase_slider_value(lower_strap_feed); }
 void increase_slider_value(int eeprom_value_number) {
   long max_value = 350; // [mm]
   long interval = 5;
@@ -565,90 +640,75 @@ void decrease_slider_value(int eeprom_value_number) {
   }
 }
 
-void switch_continuous_mode_push(void *ptr) {
+void switch_continuous_mode_push() {
   state_controller.set_continuous_mode();
-  nex_state_continuous_mode = !nex_state_continuous_mode;
+  shadow_page_2.invalidate(page_2_continuous_mode);
 }
 
 // TOUCH EVENT FUNCTIONS PAGE 2 - RIGHT SIDE -----------------------------------
 
-void button_reset_shorttime_counter_push(void *ptr) {
+void button_reset_shorttime_counter_push() {
   counter.set_value(shorttime_counter, 0);
 
   // ACTIVATE TIMEOUT TO RESET LONGTIME COUNTER:
   nex_reset_button_timeout.reset_time();
   nex_reset_button_timeout.set_flag_activated(1);
 }
-void button_reset_shorttime_counter_pop(void *ptr) {
+void button_reset_shorttime_counter_pop() {
   nex_reset_button_timeout.set_flag_activated(0);
 }
 
 // PAGE CHANGING EVENTS (TRIGGER UPDATE OF ALL DISPLAY ELEMENTS) ---------------
 
-void page_0_push(void *ptr) { nex_current_page = 0; }
-void page_1_push(void *ptr) {
+void page_1_push() {
   nex_current_page = 1;
   hide_info_field();
-
-  // REFRESH BUTTON STATES:
-  nex_prev_cycle_step = !state_controller.get_current_step();
-  nex_state_step_mode = true;
-  nex_state_air_release = 1;
-  nex_state_motor_brake = 0;
-  nex_state_upper_motor = 0;
-  nex_state_sledge = 0;
-  nex_state_blade = 0;
-  nex_state_lower_motor = 0;
-  nex_state_machine_running = 0;
-  traffic_light.set_info_has_changed();
-}
-void page_2_push(void *ptr) {
+  shadow_page_1.invalidate(); // repaint the page over the next loops
+}
+void page_2_push() {
   nex_current_page = 2;
-  update_field_values_page_2();
+  shadow_page_2.invalidate();
 }
-void update_field_values_page_2() {
-  nex_upper_strap_feed = counter.get_value(nex_upper_strap_feed) - 1;
-  nex_lower_strap_feed = counter.get_value(nex_lower_strap_feed) - 1;
-  nex_shorttime_counter = counter.get_value(nex_upper_strap_feed) - 1;
-  nex_longtime_counter = counter.get_value(nex_upper_strap_feed) - 1;
-  //nex_state_continuous_mode = true;
+void page_3_push() {
+  nex_current_page = 3;
+  shadow_page_3.invalidate();
 }
 
 // DECLARE DISPLAY EVENT LISTENERS *********************************************
 
 void attach_push_and_pop() {
   // PAGE 0 PUSH ONLY:
-  nex_page_0.attachPush(page_0_push);
+  nextion_receiver.attach_push(nex_page_0, [] { nex_current_page = 0; });
   // PAGE 1 PUSH ONLY:
-  nex_page_1.attachPush(page_1_push);
-  button_previous_step.attachPush(button_stepback_push);
-  button_next_step.attachPush(button_next_step_push);
-  button_reset_cycle.attachPush(button_reset_cycle_push);
-  button_previous_step.attachPush(button_stepback_push);
-  button_next_step.attachPush(button_next_step_push);
-  button_traffic_light.attachPush(button_traffic_light_push);
-  switch_step_auto_mode.attachPush(switch_step_auto_mode_push);
-  switch_motor_brake.attachPush(switch_motor_brake_push);
-  switch_air_release.attachPush(switch_air_release_push);
+  nextion_receiver.attach_push(nex_page_1, page_1_push);
+  nextion_receiver.attach_push(button_previous_step, button_stepback_push);
+  nextion_receiver.attach_push(button_next_step, button_next_step_push);
+  nextion_receiver.attach_push(button_reset_cycle, button_reset_cycle_push);
+  nextion_receiver.attach_push(button_traffic_light, button_traffic_light_push);
+  nextion_receiver.attach_push(switch_step_auto_mode, switch_step_auto_mode_push);
+  nextion_receiver.attach_push(switch_motor_brake, switch_motor_brake_push);
+  nextion_receiver.attach_push(switch_air_release, switch_air_release_push);
   // PAGE 1 PUSH AND POP:
-  button_upper_motor.attachPush(button_motor_oben_push);
-  button_upper_motor.attachPop(button_motor_oben_pop);
-  button_lower_motor.attachPush(button_motor_unten_push);
-  button_lower_motor.attachPop(button_motor_unten_pop);
-  button_cut.attachPush(button_schneiden_push);
-  button_cut.attachPop(button_schneiden_pop);
-  button_sledge.attachPush(button_schlitten_push);
-  button_sledge.attachPop(button_schlitten_pop);
+  nextion_receiver.attach_push(button_upper_motor, start_upper_motor);
+  nextion_receiver.attach_pop(button_upper_motor, stop_upper_motor);
+  nextion_receiver.attach_push(button_lower_motor, start_lower_motor);
+  nextion_receiver.attach_pop(button_lower_motor, stop_lower_motor);
+  nextion_receiver.attach_push(button_cut, button_schneiden_push);
+  nextion_receiver.attach_pop(button_cut, button_schneiden_pop);
+  nextion_receiver.attach_push(button_sledge, [] { cylinder_sledge_inlet.set(1); });
+  nextion_receiver.attach_pop(button_sledge, [] { cylinder_sledge_inlet.set(0); });
   // PAGE 2 PUSH ONLY:
-  nex_page_2.attachPush(page_2_push);
-  button_slider_1_left.attachPush(button_upper_slider_left_push);
-  button_slider_1_right.attachPush(button_upper_slider_right_push);
-  button_slider_2_left.attachPush(button_lower_slider_left_push);
-  button_slider_2_right.attachPush(button_lower_slider_right_push);
-  switch_continuous_mode.attachPush(switch_continuous_mode_push);
+  nextion_receiver.attach_push(nex_page_2, page_2_push);
+  nextion_receiver.attach_push(button_slider_1_left, [] { decrease_slider_value(upper_strap_feed); });
+  nextion_receiver.attach_push(button_slider_1_right, [] { increase_slider_value(upper_strap_feed); });
+  nextion_receiver.attach_push(button_slider_2_left, [] { decrease_slider_value(lower_strap_feed); });
+  nextion_receiver.attach_push(button_slider_2_right, [] { increase_slider_value(lower_strap_feed); });
+  nextion_receiver.attach_push(switch_continuous_mode, switch_continuous_mode_push);
   // PAGE 2 PUSH AND POP:
-  button_reset_shorttime_counter.attachPush(button_reset_shorttime_counter_push);
-  button_reset_shorttime_counter.attachPop(button_reset_shorttime_counter_pop);
+  nextion_receiver.attach_push(button_reset_shorttime_counter, button_reset_shorttime_counter_push);
+  nextion_receiver.attach_pop(button_reset_shorttime_counter, button_reset_shorttime_counter_pop);
+  // PAGE 3 PUSH ONLY:
+  nextion_receiver.attach_push(nex_page_3, page_3_push);
 }
 
 // DISPLAY SETUP ***************************************************************
@@ -661,14 +721,14 @@ void nextion_display_setup() {
   send_to_nextion(); // needed to start communication
   Serial2.print("rest"); // Reset
   send_to_nextion();
-  sendCommand("page 0");
+  Serial2.print("page 0");
   send_to_nextion();
 
   attach_push_and_pop();
   traffic_light.set_info_start();
 
   delay(4000);
-  sendCommand("page 1"); // switch display to page x
+  Serial2.print("page 1"); // switch display to page x
   send_to_nextion();
 }
 
@@ -676,202 +736,141 @@ void nextion_display_setup() {
 
 void nextion_display_loop() {
   //****************************************************************************
-  nexLoop(nex_listen_list); // check for any touch event
+  nextion_receiver.read(Serial2); // check for any touch event, never waits
 
+  // SEND THE CHANGED VALUES OF THE CURRENT PAGE:
   if (nex_current_page == 1) {
-    display_loop_page_1_left_side();
-    display_loop_page_1_right_side();
+    shadow_page_1.push_changes(Serial2);
   }
 
   if (nex_current_page == 2) {
-    display_loop_page_2_left_side();
-    display_loop_page_2_right_side();
-  }
-}
-
-// DISPLAY LOOP PAGE 1 LEFT SIDE: -----------------------------------------------
-
-void display_loop_page_1_left_side() {
-
-  update_cycle_name();
-  update_traffic_light_field();
-
-  // UPDATE SWITCHSTATE "STEP"/"AUTO"-MODE:
-  if (nex_state_step_mode != state_controller.is_in_step_mode()) {
-    toggle_ds_switch("bt1");
-    nex_state_step_mode = state_controller.is_in_step_mode();
-  }
-}
-
-void update_main_cycle_name() {
-  if (nex_prev_cycle_step != state_controller.get_current_step()) {
-    String number = String(state_controller.get_current_step() + 1);
-    String name = get_main_cycle_display_string();
-    Serial.println(number + " " + name);
-    display_text_in_field(number + " " + name, "t0");
-    nex_prev_cycle_step = state_controller.get_current_step();
+    shadow_page_2.push_changes(Serial2);
+    reset_lower_counter_value();
   }
-}
 
-void update_continuous_cycle_name() {
-  if (nex_prev_cycle_step != state_controller.get_current_step()) {
-    String number = String(state_controller.get_current_step() + 1);
-    String name = get_continuous_cycle_display_string();
-    Serial.println(number + " " + name);
-    display_text_in_field(number + " " + name, "t0");
-    nex_prev_cycle_step = state_controller.get_current_step();
+  if (nex_current_page == 3) {
+    shadow_page_3.push_changes(Serial2);
   }
 }
 
-void update_cycle_name() {
-  if (state_controller.is_in_step_mode() || state_controller.is_in_auto_mode()) {
-    update_main_cycle_name();
-  }
-
-  if (state_controller.is_in_continuous_mode()) {
-    update_continuous_cycle_name();
+void reset_lower_counter_value() {
+  if (nex_reset_button_timeout.is_marked_activated()) {
+    if (nex_reset_button_timeout.has_timed_out()) {
+      counter.set_value(longtime_counter, 0);
+    }
   }
 }
 
-String get_main_cycle_display_string() {
-  int current_step = state_controller.get_current_step();
-  String display_text_cycle_name = main_cycle_steps[current_step]->get_display_text();
-  return display_text_cycle_name;
-}
-
-String get_continuous_cycle_display_string() {
-  int current_step = state_controller.get_current_step();
-  String display_text_cycle_name = continuous_cycle_steps[current_step]->get_display_text();
-  return display_text_cycle_name;
-}
+// TELEMETRY *******************************************************************
 
-void update_traffic_light_field() {
-  if (traffic_light.info_has_changed()) {
-    String color = traffic_light.get_info_color();
-    set_traffic_light_field_color(color);
-    String text = traffic_light.get_info_text();
-    set_traffic_light_field_text(text);
+void send_step_telemetry() {
+  static long previous_value = -1;
+  long value = get_cycle_name_value();
+  if (value != previous_value) {
+    byte mode = state_controller.is_in_continuous_mode(); // 0 = main cycle, 1 = continuous
+    char display_text[cycle_display_text_size];
+    get_cycle_display_text(display_text, sizeof(display_text));
+    telemetry.send_step(mode, state_controller.get_current_step(), display_text);
+    previous_value = value;
   }
 }
 
-void set_traffic_light_field_text(String text) { display_text_in_field(text, "b8"); }
-
-void set_traffic_light_field_color(String color) {
-  Serial2.print("b8.bco=" + color);
-  send_to_nextion();
-}
-
-// DISPLAY LOOP PAGE 1 RIGHT SIDE: ---------------------------------------------
-
-void display_loop_page_1_right_side() {
-
-  // UPDATE SWITCHES:
-  if (cylinder_sledge_vent.get_state() != nex_state_air_release) {
-    toggle_ds_switch("bt3");
-    nex_state_air_release = !nex_state_air_release;
+void send_force_telemetry() {
+  static const unsigned long sample_interval = 1000; // [micros] = 1 kHz
+  static unsigned long previous_micros;
+  if (!telemetry.is_enabled(Telemetry::channel_force)) {
+    return;
   }
-  if (motor_upper_enable.get_state() != nex_state_motor_brake) {
-    toggle_ds_switch("bt5");
-    nex_state_motor_brake = !nex_state_motor_brake;
+  if (micros() - previous_micros >= sample_interval) {
+    previous_micros = micros();
+    telemetry.send_force(measure_force());
   }
+}
 
-  // UPDATE BUTTONS:
-  if (cylinder_sledge_inlet.get_state() != nex_state_sledge) {
-    bool state = cylinder_sledge_inlet.get_state();
-    String button = "b6";
-    set_momentary_button_high_or_low(button, state);
-    nex_state_sledge = cylinder_sledge_inlet.get_state();
+void send_counter_telemetry() {
+  static long previous_values[end_of_counter_enum];
+  static bool values_have_been_sent = false;
+  if (!telemetry_counter_timeout.has_timed_out()) {
+    return;
   }
-  if (motor_upper_pulse.get_state() != nex_state_upper_motor) {
-    bool state = motor_upper_pulse.get_state();
-    String button = "b4";
-    set_momentary_button_high_or_low(button, state);
-    nex_state_upper_motor = motor_upper_pulse.get_state();
-  }
-  if (cylinder_blade.get_state() != nex_state_blade) {
-    bool state = cylinder_blade.get_state();
-    String button = "b5";
-    set_momentary_button_high_or_low(button, state);
-    nex_state_blade = cylinder_blade.get_state();
-  }
-  if (motor_lower_pulse.get_state() != nex_state_lower_motor) {
-    bool state = motor_lower_pulse.get_state();
-    String button = "b3";
-    set_momentary_button_high_or_low(button, state);
-    nex_state_lower_motor = motor_lower_pulse.get_state();
+  telemetry_counter_timeout.reset_time();
+  for (int i = 0; i < end_of_counter_enum; i++) {
+    long value = counter.get_value(i);
+    if (value != previous_values[i] || !values_have_been_sent) {
+      telemetry.send_counter(i, value);
+      previous_values[i] = value;
+    }
   }
+  values_have_been_sent = true;
 }
 
-// DIPLAY LOOP PAGE 2 LEFT SIDE: -----------------------------------------------
-
-void display_loop_page_2_left_side() {
-  update_upper_slider_value();
-  update_lower_slider_value();
-  update_switches_page_2_left();
-
-  // UPDATE SWITCH:
+uint16_t get_output_states() {
+  // Bit order has to match OUTPUTS in tools/telemetry_decoder.py
+  uint16_t output_states = 0;
+  output_states |= cylinder_sledge_inlet.get_state() << 0;
+  output_states |= cylinder_sledge_vent.get_state() << 1;
+  output_states |= cylinder_blade.get_state() << 2;
+  output_states |= cylinder_frontclap.get_state() << 3;
+  output_states |= motor_upper_enable.get_state() << 4;
+  output_states |= motor_lower_enable.get_state() << 5;
+  output_states |= motor_upper_pulse.get_state() << 6;
+  output_states |= motor_lower_pulse.get_state() << 7;
+  output_states |= green_light_lamp.get_state() << 8;
+  output_states |= red_light_lamp.get_state() << 9;
+  return output_states;
 }
 
-void update_upper_slider_value() {
-  if (counter.get_value(upper_strap_feed) != nex_upper_strap_feed) {
-    display_text_in_field(add_suffix_to_eeprom_value(upper_strap_feed, "mm"), "t4");
-    nex_upper_strap_feed = counter.get_value(upper_strap_feed);
-  }
-}
-void update_lower_slider_value() {
-  if (counter.get_value(lower_strap_feed) != nex_lower_strap_feed) {
-    display_text_in_field(add_suffix_to_eeprom_value(lower_strap_feed, "mm"), "t2");
-    nex_lower_strap_feed = counter.get_value(lower_strap_feed);
+void send_output_telemetry() {
+  static long previous_output_states = -1;
+  uint16_t output_states = get_output_states();
+  if (output_states != previous_output_states) {
+    telemetry.send_outputs(output_states);
+    previous_output_states = output_states;
   }
 }
-String add_suffix_to_eeprom_value(int eeprom_value_number, String suffix) {
-  String value = String(counter.get_value(eeprom_value_number));
-  String space = " ";
-  String suffixed_string = value + space + suffix;
-  return suffixed_string;
-}
-void update_switches_page_2_left() {
-  if (state_controller.is_in_continuous_mode() != nex_state_continuous_mode) {
-    toggle_ds_switch("bt3");
-    nex_state_continuous_mode = !nex_state_continuous_mode;
-  }
-}
-
-// DIPLAY LOOP PAGE 2 RIGHT SIDE: ----------------------------------------------
 
-void display_loop_page_2_right_side() {
-  update_upper_counter_value();
-  update_lower_counter_value();
-  reset_lower_counter_value();
-}
+void send_loop_timing_telemetry(unsigned long runtime) {
+  static unsigned long runtime_sum;
+  static unsigned long max_runtime;
+  static unsigned long loops;
+  runtime_sum += runtime;
+  max_runtime = max(max_runtime, runtime);
+  loops++;
 
-void update_upper_counter_value() {
-  if (nex_longtime_counter != counter.get_value(longtime_counter)) {
-    display_text_in_field(String(counter.get_value(longtime_counter)), "t10");
-    nex_longtime_counter = counter.get_value(longtime_counter);
+  if (print_interval_timeout.has_timed_out()) {
+    telemetry.send_loop_timing(runtime_sum / loops, max_runtime, loops);
+    runtime_sum = 0;
+    max_runtime = 0;
+    loops = 0;
+    print_interval_timeout.reset_time();
   }
 }
-void update_lower_counter_value() {
-  // UPDATE LOWER COUNTER:
-  if (nex_shorttime_counter != counter.get_value(shorttime_counter)) {
-    display_text_in_field(String(counter.get_value(shorttime_counter)), "t12");
-    nex_shorttime_counter = counter.get_value(shorttime_counter);
+
+void send_memory_telemetry() {
+  if (telemetry_memory_timeout.has_timed_out()) {
+    telemetry.send_memory(memory_monitor.get_free_ram(), memory_monitor.get_min_stack_headroom(),
+                          memory_monitor.get_heap_free(), memory_monitor.get_largest_free_block(),
+                          memory_monitor.get_brkval(), memory_monitor.get_no_of_pool_exhaustions());
+    telemetry_memory_timeout.reset_time();
   }
 }
-void reset_lower_counter_value() {
-  if (nex_reset_button_timeout.is_marked_activated()) {
-    if (nex_reset_button_timeout.has_timed_out()) {
-      counter.set_value(longtime_counter, 0);
-    }
-  }
+
+void telemetry_loop(unsigned long runtime) {
+  telemetry.read_channel_selection();
+  send_step_telemetry();
+  send_force_telemetry();
+  send_counter_telemetry();
+  send_output_telemetry();
+  send_loop_timing_telemetry(runtime);
+  send_memory_telemetry();
 }
 
 // CLASSES FOR THE MAIN CYCLE STEPS ********************************************
 // STEP-MODE AND AUTO MODE
 
 //------------------------------------------------------------------------------
-class User_do_stuff : public Cycle_step {
-  String get_display_text() { return "SPANNEN + CRIMPEN"; }
+class User_do_stuff : public Static_cycle_step<User_do_stuff> {
+public:
   int substep = 0;
 
   void do_initial_stuff() {
@@ -880,7 +879,7 @@ class User_do_stuff : public Cycle_step {
     traffic_light.set_info_user_do_stuff();
     substep = 0;
     show_info_field();
-    display_text_in_info_field("ZUGKRAFT");
+    display_force_label_in_info_field();
     cycle_step_delay.set_unstarted();
   }
   void do_loop_stuff() {
@@ -897,8 +896,8 @@ class User_do_stuff : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Release_air : public Cycle_step {
-  String get_display_text() { return "LUFT ABLASSEN"; }
+class Release_air : public Static_cycle_step<Release_air> {
+public:
 
   void do_initial_stuff() {
     traffic_light.set_info_machine_do_stuff();
@@ -913,8 +912,8 @@ class Release_air : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Release_brake : public Cycle_step {
-  String get_display_text() { return "BREMSE LOESEN"; }
+class Release_brake : public Static_cycle_step<Release_brake> {
+public:
 
   void do_initial_stuff() {
     vent_sledge();
@@ -930,8 +929,8 @@ class Release_brake : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Sledge_back : public Cycle_step {
-  String get_display_text() { return "ZURUECKFAHREN"; }
+class Sledge_back : public Static_cycle_step<Sledge_back> {
+public:
 
   void do_initial_stuff() {
     traffic_light.set_info_machine_do_stuff();
@@ -947,8 +946,8 @@ class Sledge_back : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Cut_strap : public Cycle_step {
-  String get_display_text() { return "SCHNEIDEN"; }
+class Cut_strap : public Static_cycle_step<Cut_strap> {
+public:
 
   void do_initial_stuff() {
     traffic_light.set_info_machine_do_stuff();
@@ -965,8 +964,8 @@ class Cut_strap : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Feed_straps : public Cycle_step {
-  String get_display_text() { return "BAND VORSCHIEBEN"; }
+class Feed_straps : public Static_cycle_step<Feed_straps> {
+public:
   bool upper_strap_completed = false;
   bool lower_strap_completed = false;
 
@@ -1009,8 +1008,8 @@ class Feed_straps : public Cycle_step {
 
 // CLASSES FOR CONTINUOUS MODE *************************************************
 
-class Continuous_vent : public Cycle_step {
-  String get_display_text() { return "ENTLUEFTEN"; }
+class Continuous_vent : public Static_cycle_step<Continuous_vent> {
+public:
 
   void do_initial_stuff() {
     traffic_light.set_info_user_do_stuff();
@@ -1024,8 +1023,8 @@ class Continuous_vent : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Continuous_sledge_back : public Cycle_step {
-  String get_display_text() { return "ZURUECKFAHREN"; }
+class Continuous_sledge_back : public Static_cycle_step<Continuous_sledge_back> {
+public:
   bool has_reached_startpoint = false;
 
   void do_initial_stuff() {
@@ -1051,8 +1050,8 @@ class Continuous_sledge_back : public Cycle_step {
   }
 };
 //------------------------------------------------------------------------------
-class Continuous_release_pulses : public Cycle_step {
-  String get_display_text() { return "PULSEN"; }
+class Continuous_release_pulses : public Static_cycle_step<Continuous_release_pulses> {
+public:
   int substep = 1;
 
   void do_initial_stuff() {
@@ -1061,7 +1060,7 @@ class Continuous_release_pulses : public Cycle_step {
     traffic_light.set_info_user_do_stuff();
     substep = 1;
     show_info_field();
-    display_text_in_info_field("ZUGKRAFT");
+    display_force_label_in_info_field();
     cycle_step_delay.set_unstarted();
   }
   void do_loop_stuff() {
@@ -1086,6 +1085,56 @@ class Continuous_release_pulses : public Cycle_step {
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 
+// CYCLE STEP SEQUENCES ********************************************************
+// SEQUENCE OF THE TEMPLATE ARGUMENTS = CYCLE SEQUENCE!
+// One display text per step in the same order, stored in flash:
+
+const char main_step_text_0[] PROGMEM = "SPANNEN + CRIMPEN";
+const char main_step_text_1[] PROGMEM = "LUFT ABLASSEN";
+const char main_step_text_2[] PROGMEM = "BREMSE LOESEN";
+const char main_step_text_3[] PROGMEM = "ZURUECKFAHREN";
+const char main_step_text_4[] PROGMEM = "SCHNEIDEN";
+const char main_step_text_5[] PROGMEM = "BAND VORSCHIEBEN";
+const char *const main_step_texts[] PROGMEM = {main_step_text_0, main_step_text_1,
+                                               main_step_text_2, main_step_text_3,
+                                               main_step_text_4, main_step_text_5};
+
+const char continuous_step_text_0[] PROGMEM = "ENTLUEFTEN";
+const char continuous_step_text_1[] PROGMEM = "ZURUECKFAHREN";
+const char continuous_step_text_2[] PROGMEM = "PULSEN";
+const char *const continuous_step_texts[] PROGMEM = {
+    continuous_step_text_0, continuous_step_text_1, continuous_step_text_2};
+
+Cycle_sequence<User_do_stuff, Release_air, Release_brake, Sledge_back, Cut_strap, Feed_straps>
+    main_cycle_steps(main_step_texts);
+Cycle_sequence<Continuous_vent, Continuous_sledge_back, Continuous_release_pulses>
+    continuous_cycle_steps(continuous_step_texts);
+
+static_assert(sizeof(main_step_texts) / sizeof(main_step_texts[0]) == main_cycle_steps.size(),
+              "one display text per main cycle step");
+static_assert(sizeof(continuous_step_texts) / sizeof(continuous_step_texts[0]) ==
+                  continuous_cycle_steps.size(),
+              "one display text per continuous step");
+
+void reset_flag_of_current_step() {
+
+  if (state_controller.is_in_auto_mode() || state_controller.is_in_step_mode()) {
+    main_cycle_steps.reset_flags(state_controller.get_current_step());
+  }
+  if (state_controller.is_in_continuous_mode()) {
+    continuous_cycle_steps.reset_flags(state_controller.get_current_step());
+  }
+}
+
+void get_cycle_display_text(char *buffer, byte buffer_size) {
+  byte current_step = state_controller.get_current_step();
+  if (state_controller.is_in_continuous_mode()) {
+    continuous_cycle_steps.get_display_text(current_step, buffer, buffer_size);
+    return;
+  }
+  main_cycle_steps.get_display_text(current_step, buffer, buffer_size);
+}
+
 // STEPPER MOTOR SETUP *********************************************************
 
 void setup_stepper_motors() {
@@ -1107,25 +1156,9 @@ void setup() {
   // n.a.
 
   //------------------------------------------------
-  // PUSH THE CYCLE STEPS INTO THE VECTOR CONTAINER:
-  // PUSH SEQUENCE = CYCLE SEQUENCE!
-  main_cycle_steps.push_back(new User_do_stuff);
-  main_cycle_steps.push_back(new Release_air);
-  main_cycle_steps.push_back(new Release_brake);
-  main_cycle_steps.push_back(new Sledge_back);
-  main_cycle_steps.push_back(new Cut_strap);
-  main_cycle_steps.push_back(new Feed_straps);
-  //------------------------------------------------
-  // CONFIGURE THE STATE CONTROLLER:
-  int no_of_main_cycle_steps = main_cycle_steps.size();
-  state_controller.set_no_of_steps(no_of_main_cycle_steps);
-  //------------------------------------------------
-  // PUSH THE STEPS FOR CONTINUOUS MODE IN A CONTAINER:
-  continuous_cycle_steps.push_back(new Continuous_vent);
-  continuous_cycle_steps.push_back(new Continuous_sledge_back);
-  continuous_cycle_steps.push_back(new Continuous_release_pulses);
-  int no_of_continuous_cycle_steps = continuous_cycle_steps.size();
-  state_controller.set_no_of_continuous_steps(no_of_continuous_cycle_steps);
+  // CONFIGURE THE STATE CONTROLLER (STEPS SEE CYCLE STEP SEQUENCES):
+  state_controller.set_no_of_steps(main_cycle_steps.size());
+  state_controller.set_no_of_continuous_steps(continuous_cycle_steps.size());
   //------------------------------------------------
   // SETUP COUNTER:
   counter.setup(0, 1023, counter_no_of_values);
@@ -1133,7 +1166,11 @@ void setup() {
   Serial.begin(115200);
   state_controller.set_auto_mode();
   state_controller.set_machine_running();
-  Serial.println("EXIT SETUP");
+  //------------------------------------------------
+  // SETUP TELEMETRY (FORCE SAMPLES ONLY ON REQUEST OF THE HOST, 1 kHz):
+  telemetry.set_channels(1 << Telemetry::channel_step | 1 << Telemetry::channel_loop_timing |
+                         1 << Telemetry::channel_counter | 1 << Telemetry::channel_outputs |
+                         1 << Telemetry::channel_memory);
   //------------------------------------------------
   nextion_display_setup();
   // REQUIRED STEP TO MAKE SKETCH WORK AFTER RESET:
@@ -1145,7 +1182,7 @@ void setup() {
 void run_step_or_auto_mode() {
 
   // IF STEP IS COMPLETED SWITCH TO NEXT STEP:
-  if (main_cycle_steps[state_controller.get_current_step()]->is_completed()) {
+  if (main_cycle_steps.is_completed(state_controller.get_current_step())) {
     state_controller.switch_to_next_step();
     reset_flag_of_current_step();
   }
@@ -1159,7 +1196,7 @@ void run_step_or_auto_mode() {
 
   // IF MACHINE STATE IS "RUNNING", RUN CURRENT STEP:
   if (state_controller.machine_is_running()) {
-    main_cycle_steps[state_controller.get_current_step()]->do_stuff();
+    main_cycle_steps.do_stuff(state_controller.get_current_step());
   }
 
   // MEASURE AND DISPLAY PRESSURE
@@ -1168,14 +1205,14 @@ void run_step_or_auto_mode() {
 
 void run_continuous_mode() {
   // IF STEP IS COMPLETED SWITCH TO NEXT STEP:
-  if (continuous_cycle_steps[state_controller.get_current_step()]->is_completed()) {
+  if (continuous_cycle_steps.is_completed(state_controller.get_current_step())) {
     state_controller.switch_to_next_step();
     reset_flag_of_current_step();
   }
 
   // IF MACHINE STATE IS "RUNNING", RUN CURRENT STEP:
   if (state_controller.machine_is_running()) {
-    continuous_cycle_steps[state_controller.get_current_step()]->do_stuff();
+    continuous_cycle_steps.do_stuff(state_controller.get_current_step());
   }
 
   // MEASURE AND DISPLAY PRESSURE
@@ -1190,6 +1227,9 @@ void loop() {
   // MONITOR MOTOR BRAKE TO PREVENT FROM OVERHEATING:
   monitor_motor_output();
 
+  // MONITOR MEMORY TO STOP BEFORE HEAP AND STACK COLLIDE:
+  monitor_memory();
+
   // RUN STEP OR AUTO MODE:
   if (state_controller.is_in_step_mode() || state_controller.is_in_auto_mode()) {
     run_step_or_auto_mode();
@@ -1208,12 +1248,9 @@ void loop() {
   // MANAGE TRAFFIC LIGHTS:
   manage_traffic_lights();
 
-  // DISPLAY DEBUG INFOMATION:
+  // SEND DEBUG INFORMATION TO THE HOST:
   unsigned long runtime = measure_runtime();
-  if (print_interval_timeout.has_timed_out()) {
-    //Serial.println(runtime);
-    print_interval_timeout.reset_time();
-  }
+  telemetry_loop(runtime);
 }
 
 // END OF PROGRAM **************************************************************
\ No newline at end of file
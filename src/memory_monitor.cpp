@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * memory_monitor.cpp **********************************************************
+ *******************************************************************************/
+
+#include "memory_monitor.h"
+#include <pool_allocator>
+
+// SYMBOLS OF THE LINKER AND OF MALLOC() (avr-libc) ----------------------------
+struct __freelist {
+  size_t sz;
+  struct __freelist *nx;
+};
+extern struct __freelist *__flp; // first block of the free list
+extern char *__brkval; // end of the heap, 0 before the first malloc()
+extern uint8_t __heap_start;
+extern uint8_t __stack; // = RAMEND
+
+namespace {
+const uint8_t canary = 0xa5;
+
+uint8_t *get_heap_end() { return __brkval ? (uint8_t *)__brkval : &__heap_start; }
+} // namespace
+
+// PAINT THE FREE RAM BEFORE ANY CONSTRUCTOR RUNS ------------------------------
+// Runs in .init3, the stack is still empty. Naked: must not use the stack.
+void paint_free_ram() __attribute__((naked, used, section(".init3")));
+void paint_free_ram() {
+  for (uint8_t *p = &__heap_start; p <= &__stack; p++) {
+    *p = canary;
+  }
+}
+
+// CONSTRUCTOR -----------------------------------------------------------------
+Memory_monitor::Memory_monitor(unsigned int alarm_threshold) {
+  _alarm_threshold = alarm_threshold;
+  _free_ram = 0;
+  _min_stack_headroom = 0xffff; // not measured yet
+  _heap_free = 0;
+  _largest_free_block = 0;
+  _heap_high_water = &__heap_start;
+  _scan_pointer = &__heap_start;
+  _alarm_is_active = false;
+}
+
+// MEASUREMENTS ----------------------------------------------------------------
+void Memory_monitor::update() {
+  uint8_t *heap_end = get_heap_end();
+  _free_ram = (uint8_t *)SP - heap_end;
+  update_free_list();
+  continue_stack_scan();
+
+  if (_min_stack_headroom < _alarm_threshold) {
+    _alarm_is_active = true;
+  }
+}
+
+void Memory_monitor::update_free_list() {
+  _heap_free = 0;
+  _largest_free_block = 0;
+  for (struct __freelist *block = __flp; block; block = block->nx) {
+    _heap_free += block->sz;
+    _largest_free_block = max(_largest_free_block, (unsigned int)block->sz);
+  }
+}
+
+void Memory_monitor::continue_stack_scan() {
+  // Freed heap memory at the top leaves its content behind, therefore the
+  // scan starts at the highest end the heap ever had:
+  uint8_t *heap_end = get_heap_end();
+  if (heap_end > _heap_high_water) {
+    _heap_high_water = heap_end;
+    _scan_pointer = heap_end;
+  }
+
+  uint8_t *stack_pointer = (uint8_t *)SP;
+  for (unsigned int i = 0; i < _bytes_per_scan; i++) {
+    // The first overwritten canary is the stack high-water mark:
+    if (_scan_pointer >= stack_pointer || *_scan_pointer != canary) {
+      unsigned int stack_headroom = _scan_pointer - _heap_high_water;
+      _min_stack_headroom = min(_min_stack_headroom, stack_headroom);
+      _scan_pointer = _heap_high_water; // start over
+      return;
+    }
+    _scan_pointer++;
+  }
+}
+
+// GETTER ----------------------------------------------------------------------
+unsigned int Memory_monitor::get_free_ram() { return _free_ram; }
+
+unsigned int Memory_monitor::get_min_stack_headroom() { return _min_stack_headroom; }
+
+unsigned int Memory_monitor::get_heap_free() { return _heap_free; }
+
+unsigned int Memory_monitor::get_largest_free_block() { return _largest_free_block; }
+
+unsigned int Memory_monitor::get_brkval() { return (uintptr_t)get_heap_end(); }
+
+unsigned int Memory_monitor::get_no_of_pool_exhaustions() { return std::pool_exhaustions(); }
+
+bool Memory_monitor::alarm_is_active() { return _alarm_is_active; }
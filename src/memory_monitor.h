@@ -0,0 +1,58 @@
+/* *****************************************************************************
+ * memory_monitor.h ************************************************************
+ * *****************************************************************************
+ * SRAM HEALTH MONITOR (AVR):
+ *
+ *  RAMSTART                                                             RAMEND
+ *  | .data .bss | heap -->   (free list)  | __brkval   free RAM   <-- stack |
+ *
+ * • at boot the free RAM between heap and stack gets painted with a canary
+ * • the lowest address the stack ever reached is the first painted byte that
+ *   has been overwritten, the search is spread over several loops
+ * • the heap fragmentation is read from the free list of malloc()
+ * • an alarm gets raised when the smallest stack headroom ever seen falls
+ *   below the alarm threshold, it stays active until the next restart
+ * • containers with a std::pool_allocator fall back to the heap when their
+ *   pool is full, these allocations get counted
+ * *****************************************************************************
+ */
+
+#ifndef MEMORY_MONITOR_H_
+#define MEMORY_MONITOR_H_
+
+#include "Arduino.h"
+
+class Memory_monitor {
+
+public:
+  // FUNCTIONS:
+  Memory_monitor(unsigned int alarm_threshold);
+  void update(); // call once per loop, takes at most a few ten micros
+
+  // GETTER:
+  unsigned int get_free_ram(); // between heap end and stack pointer now
+  unsigned int get_min_stack_headroom(); // between heap end and stack high-water mark
+  unsigned int get_heap_free(); // sum of the free list blocks
+  unsigned int get_largest_free_block(); // largest free list block
+  unsigned int get_brkval(); // current end of the heap (address)
+  unsigned int get_no_of_pool_exhaustions(); // pool allocations that went to the heap
+  bool alarm_is_active();
+
+private:
+  // FUNCTIONS:
+  void update_free_list();
+  void continue_stack_scan();
+
+  // VARIABLES:
+  static const unsigned int _bytes_per_scan = 128;
+  unsigned int _alarm_threshold;
+  unsigned int _free_ram;
+  unsigned int _min_stack_headroom;
+  unsigned int _heap_free;
+  unsigned int _largest_free_block;
+  uint8_t *_heap_high_water;
+  uint8_t *_scan_pointer;
+  bool _alarm_is_active;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * nextion_receiver.cpp ********************************************************
+ *******************************************************************************/
+
+#include "nextion_receiver.h"
+
+namespace {
+const byte touch_event_head = 0x65;
+const byte touch_event_length = 4; // head, page id, component id, event
+const byte event_push = 0x01;
+const byte event_pop = 0x00;
+const byte end_byte = 0xff;
+} // namespace
+
+// CONSTRUCTOR -----------------------------------------------------------------
+Nextion_receiver::Nextion_receiver() {
+  memset(_handler_index, 0, sizeof(_handler_index));
+  _no_of_handlers = 0;
+  _frame_length = 0;
+  _no_of_end_bytes = 0;
+  _no_of_dropped_frames = 0;
+}
+
+// CALLBACK TABLE --------------------------------------------------------------
+Nextion_receiver::Handler *Nextion_receiver::get_handler(const Nextion_object &object) {
+  if (object.page_id >= _max_pages || object.component_id >= _max_components) {
+    return NULL;
+  }
+  byte &index = _handler_index[object.page_id][object.component_id];
+  if (index == 0) {
+    if (_no_of_handlers == _max_handlers) {
+      return NULL;
+    }
+    _handlers[_no_of_handlers].push = Nextion_callback();
+    _handlers[_no_of_handlers].pop = Nextion_callback();
+    _no_of_handlers++;
+    index = _no_of_handlers;
+  }
+  return &_handlers[index - 1];
+}
+
+void Nextion_receiver::attach_push(const Nextion_object &object, Nextion_callback callback) {
+  Handler *handler = get_handler(object);
+  if (handler) {
+    handler->push = callback;
+  }
+}
+
+void Nextion_receiver::attach_pop(const Nextion_object &object, Nextion_callback callback) {
+  Handler *handler = get_handler(object);
+  if (handler) {
+    handler->pop = callback;
+  }
+}
+
+void Nextion_receiver::attach_push(const Nextion_object &object, Nextion_raw_callback callback,
+                                   void *ptr) {
+  attach_push(object, [callback, ptr] { callback(ptr); });
+}
+
+void Nextion_receiver::attach_pop(const Nextion_object &object, Nextion_raw_callback callback,
+                                  void *ptr) {
+  attach_pop(object, [callback, ptr] { callback(ptr); });
+}
+
+// PARSER ----------------------------------------------------------------------
+void Nextion_receiver::read(Stream &serial) {
+  while (serial.available() > 0) {
+    read_byte(serial.read());
+  }
+}
+
+void Nextion_receiver::read_byte(byte incoming_byte) {
+  // Every frame ends with three end bytes:
+  if (incoming_byte == end_byte) {
+    _no_of_end_bytes++;
+    if (_no_of_end_bytes == 3) {
+      dispatch_frame();
+      _frame_length = 0;
+      _no_of_end_bytes = 0;
+    }
+    return;
+  }
+
+  // Less than three end bytes have been part of the data:
+  for (; _no_of_end_bytes > 0; _no_of_end_bytes--) {
+    store_byte(end_byte);
+  }
+  store_byte(incoming_byte);
+}
+
+void Nextion_receiver::store_byte(byte data_byte) {
+  if (_frame_length < _max_frame_length) {
+    _frame[_frame_length] = data_byte;
+  }
+  if (_frame_length <= _max_frame_length) {
+    _frame_length++; // stops at _max_frame_length + 1 to mark an overflow
+  }
+}
+
+void Nextion_receiver::dispatch_frame() {
+  if (_frame_length > _max_frame_length) {
+    _no_of_dropped_frames++;
+    return;
+  }
+  // Other return codes of the display are not of interest:
+  if (_frame_length != touch_event_length || _frame[0] != touch_event_head) {
+    return;
+  }
+
+  byte page_id = _frame[1];
+  byte component_id = _frame[2];
+  if (page_id >= _max_pages || component_id >= _max_components) {
+    return;
+  }
+  byte index = _handler_index[page_id][component_id];
+  if (index == 0) {
+    return;
+  }
+
+  Handler &handler = _handlers[index - 1];
+  if (_frame[3] == event_push && handler.push) {
+    handler.push();
+  }
+  if (_frame[3] == event_pop && handler.pop) {
+    handler.pop();
+  }
+}
+
+// GETTER ----------------------------------------------------------------------
+unsigned int Nextion_receiver::get_no_of_dropped_frames() { return _no_of_dropped_frames; }
@@ -0,0 +1,78 @@
+/* *****************************************************************************
+ * nextion_receiver.h **********************************************************
+ * *****************************************************************************
+ * NON BLOCKING RECEIVER FOR NEXTION TOUCH EVENTS:
+ *
+ * Replaces nexLoop() of the itead library, which waits for incoming bytes and
+ * walks through the whole listen list for every touch event.
+ *
+ * • read() only takes the bytes that are already in the RX buffer
+ * • every byte is fed into a small state machine, no waiting at all
+ * • a touch event frame looks like: 0x65 page_id component_id event ff ff ff
+ * • the callback of a touch event is found by a table lookup (page, component)
+ * • a callback is any function or lambda of up to two pointers, stored inside
+ *   the table without heap: [] { cylinder_blade.set(1); }
+ * *****************************************************************************
+ */
+
+#ifndef NEXTION_RECEIVER_H_
+#define NEXTION_RECEIVER_H_
+
+#include "Arduino.h"
+#include <functional>
+
+typedef std::inplace_function<void()> Nextion_callback;
+typedef void (*Nextion_raw_callback)(void *ptr); // callback of the itead library
+
+struct Nextion_object {
+  byte page_id;
+  byte component_id;
+  const char *name; // nextion object name, e.g. "b1"
+};
+
+class Nextion_receiver {
+
+public:
+  // FUNCTIONS:
+  Nextion_receiver();
+
+  void attach_push(const Nextion_object &object, Nextion_callback callback);
+  void attach_pop(const Nextion_object &object, Nextion_callback callback);
+  // Adapters for callbacks of the itead library, called with ptr:
+  void attach_push(const Nextion_object &object, Nextion_raw_callback callback, void *ptr);
+  void attach_pop(const Nextion_object &object, Nextion_raw_callback callback, void *ptr);
+  void read(Stream &serial); // feeds all available bytes into the parser
+  void read_byte(byte incoming_byte);
+
+  // GETTER:
+  unsigned int get_no_of_dropped_frames();
+
+private:
+  struct Handler {
+    Nextion_callback push;
+    Nextion_callback pop;
+  };
+
+  // FUNCTIONS:
+  Handler *get_handler(const Nextion_object &object);
+  void store_byte(byte data_byte);
+  void dispatch_frame();
+
+  // VARIABLES:
+  static const byte _max_pages = 4;
+  static const byte _max_components = 24;
+  static const byte _max_handlers = 24;
+  static const byte _max_frame_length = 8;
+
+  // 0 = no handler, otherwise index + 1 into _handlers:
+  byte _handler_index[_max_pages][_max_components];
+  Handler _handlers[_max_handlers];
+  byte _no_of_handlers;
+
+  byte _frame[_max_frame_length];
+  byte _frame_length;
+  byte _no_of_end_bytes;
+  unsigned int _no_of_dropped_frames;
+};
+
+#endif
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * telemetry.cpp ***************************************************************
+ *******************************************************************************/
+
+#include "telemetry.h"
+
+namespace {
+const byte select_command = 'C';
+const byte max_text_length = 20;
+const byte frame_delimiter = 0x00;
+
+uint8_t update_crc8(uint8_t crc, uint8_t data) { // polynomial 0x07
+  crc ^= data;
+  for (byte i = 0; i < 8; i++) {
+    crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+  }
+  return crc;
+}
+} // namespace
+
+// CONSTRUCTOR -----------------------------------------------------------------
+Telemetry::Telemetry(HardwareSerial &serial) : _serial(serial) {
+  _channel_mask = 0;
+  _frame_length = 0;
+  _crc = 0;
+  _no_of_dropped_frames = 0;
+  _stream_is_synchronized = false;
+}
+
+// CHANNEL SELECTION -----------------------------------------------------------
+void Telemetry::set_channels(byte channel_mask) { _channel_mask = channel_mask; }
+
+bool Telemetry::is_enabled(channel telemetry_channel) {
+  return _channel_mask & (1 << telemetry_channel);
+}
+
+void Telemetry::read_channel_selection() {
+  while (_serial.available() >= 2) {
+    if (_serial.read() == select_command) {
+      _channel_mask = _serial.read();
+    }
+  }
+}
+
+unsigned int Telemetry::get_no_of_dropped_frames() { return _no_of_dropped_frames; }
+
+// FRAMES ----------------------------------------------------------------------
+void Telemetry::send_step(byte mode, byte step, const char *display_text) {
+  if (!begin_frame(channel_step)) {
+    return;
+  }
+  add_byte(mode);
+  add_byte(step);
+  for (byte i = 0; display_text[i] && i < max_text_length; i++) {
+    add_byte(display_text[i]);
+  }
+  send_frame();
+}
+
+void Telemetry::send_force(int force) {
+  if (!begin_frame(channel_force)) {
+    return;
+  }
+  add_uint16(force);
+  send_frame();
+}
+
+void Telemetry::send_loop_timing(unsigned long average_runtime, unsigned long max_runtime,
+                                 unsigned long loops) {
+  if (!begin_frame(channel_loop_timing)) {
+    return;
+  }
+  add_uint32(average_runtime);
+  add_uint32(max_runtime);
+  add_uint32(loops);
+  add_uint16(_no_of_dropped_frames);
+  send_frame();
+}
+
+void Telemetry::send_counter(byte counter_number, long value) {
+  if (!begin_frame(channel_counter)) {
+    return;
+  }
+  add_byte(counter_number);
+  add_uint32(value);
+  send_frame();
+}
+
+void Telemetry::send_outputs(uint16_t output_states) {
+  if (!begin_frame(channel_outputs)) {
+    return;
+  }
+  add_uint16(output_states);
+  send_frame();
+}
+
+void Telemetry::send_memory(uint16_t free_ram, uint16_t min_stack_headroom, uint16_t heap_free,
+                            uint16_t largest_free_block, uint16_t heap_end,
+                            uint16_t pool_exhaustions) {
+  if (!begin_frame(channel_memory)) {
+    return;
+  }
+  add_uint16(free_ram);
+  add_uint16(min_stack_headroom);
+  add_uint16(heap_free);
+  add_uint16(largest_free_block);
+  add_uint16(heap_end);
+  add_uint16(pool_exhaustions);
+  send_frame();
+}
+
+// FRAME ASSEMBLY --------------------------------------------------------------
+bool Telemetry::begin_frame(channel telemetry_channel) {
+  if (!is_enabled(telemetry_channel)) {
+    return false;
+  }
+  _frame_length = 0;
+  _crc = 0;
+  add_byte(telemetry_channel);
+  add_uint32(micros());
+  return true;
+}
+
+void Telemetry::add_byte(uint8_t value) {
+  // Leave space for the CRC:
+  if (_frame_length < _max_frame_length - 1) {
+    _frame[_frame_length++] = value;
+    _crc = update_crc8(_crc, value);
+  }
+}
+
+void Telemetry::add_uint16(uint16_t value) {
+  add_byte(value);
+  add_byte(value >> 8);
+}
+
+void Telemetry::add_uint32(uint32_t value) {
+  add_uint16(value);
+  add_uint16(value >> 16);
+}
+
+void Telemetry::send_frame() {
+  _frame[_frame_length++] = _crc;
+
+  // COBS: every zero gets replaced by the distance to the next zero
+  // (frames are shorter than 254 bytes, no blocks have to be split):
+  uint8_t encoded[_max_frame_length + 2];
+  byte code_position = 0;
+  byte encoded_length = 1;
+  uint8_t code = 1;
+  for (byte i = 0; i < _frame_length; i++) {
+    if (_frame[i] == 0) {
+      encoded[code_position] = code;
+      code_position = encoded_length++;
+      code = 1;
+    } else {
+      encoded[encoded_length++] = _frame[i];
+      code++;
+    }
+  }
+  encoded[code_position] = code;
+  encoded[encoded_length++] = frame_delimiter;
+
+  // Never block the loop:
+  if (_serial.availableForWrite() <= encoded_length) {
+    _no_of_dropped_frames++;
+    return;
+  }
+  // Text printed before the first frame must not corrupt it:
+  if (!_stream_is_synchronized) {
+    _serial.write(frame_delimiter);
+    _stream_is_synchronized = true;
+  }
+  _serial.write(encoded, encoded_length);
+}
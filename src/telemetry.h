@@ -0,0 +1,83 @@
+/* *****************************************************************************
+ * telemetry.h *****************************************************************
+ * *****************************************************************************
+ * BINARY TELEMETRY STREAM:
+ *
+ * Sends machine data as small binary frames instead of text lines.
+ * Decoder for the host: tools/telemetry_decoder.py
+ *
+ * FRAME (before encoding, multi byte values are little endian):
+ * channel (1 byte) | timestamp micros (4 bytes) | payload | CRC-8 (1 byte)
+ *
+ * Every frame is COBS encoded and terminated with 0x00, a decoder can
+ * therefore resynchronize at any zero byte.
+ *
+ * CHANNEL SELECTION:
+ * Every channel can be switched on and off with set_channels(), or by the
+ * host at runtime by sending two bytes: 'C' channel_mask
+ *
+ * A frame that does not fit into the free TX buffer gets dropped instead of
+ * blocking the loop, the drops are reported in the loop timing frame.
+ * *****************************************************************************
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include "Arduino.h"
+
+class Telemetry {
+
+public:
+  enum channel {
+    channel_step, // mode, step number, display text
+    channel_force, // force [N]
+    channel_loop_timing, // average and max runtime [micros], loops, dropped frames
+    channel_counter, // counter number, value
+    channel_outputs, // one bit per output
+    channel_memory, // free ram, stack headroom, heap free, largest free block, heap end,
+                    // pool exhaustions
+    end_of_channel_enum // keep this entry
+  };
+
+  // FUNCTIONS:
+  Telemetry(HardwareSerial &serial);
+
+  void read_channel_selection(); // checks for a selection sent by the host
+
+  void send_step(byte mode, byte step, const char *display_text);
+  void send_force(int force);
+  void send_loop_timing(unsigned long average_runtime, unsigned long max_runtime,
+                        unsigned long loops);
+  void send_counter(byte counter_number, long value);
+  void send_outputs(uint16_t output_states);
+  void send_memory(uint16_t free_ram, uint16_t min_stack_headroom, uint16_t heap_free,
+                   uint16_t largest_free_block, uint16_t heap_end, uint16_t pool_exhaustions);
+
+  // SETTER:
+  void set_channels(byte channel_mask);
+
+  // GETTER:
+  bool is_enabled(channel telemetry_channel);
+  unsigned int get_no_of_dropped_frames();
+
+private:
+  // FUNCTIONS:
+  bool begin_frame(channel telemetry_channel);
+  void add_byte(uint8_t value);
+  void add_uint16(uint16_t value);
+  void add_uint32(uint32_t value);
+  void send_frame();
+
+  // VARIABLES:
+  static const byte _max_frame_length = 32;
+  HardwareSerial &_serial;
+  byte _channel_mask;
+  uint8_t _frame[_max_frame_length];
+  byte _frame_length;
+  uint8_t _crc;
+  unsigned int _no_of_dropped_frames;
+  bool _stream_is_synchronized;
+};
+
+#endif
@@ -2,7 +2,7 @@
 #include "Arduino.h"
 
 void Traffic_light::set_info_start() {
-  _info_has_changed = true;
+  _info = info_start;
   _info_color = _blue;
   _info_text = "START";
 
@@ -12,7 +12,7 @@ void Traffic_light::set_info_start() {
 }
 
 void Traffic_light::set_info_user_do_stuff() {
-  _info_has_changed = true;
+  _info = info_user_do_stuff;
   _info_color = _green;
   _info_text = "CRIMPEN";
   _sleep_state_active = false;
@@ -21,7 +21,7 @@ void Traffic_light::set_info_user_do_stuff() {
 }
 
 void Traffic_light::set_info_machine_do_stuff() {
-  _info_has_changed = true;
+  _info = info_machine_do_stuff;
   _info_color = _red;
   _info_text = "WARTEN";
   _sleep_state_active = false;
@@ -30,7 +30,7 @@ void Traffic_light::set_info_machine_do_stuff() {
 }
 
 void Traffic_light::set_info_sleep() {
-  _info_has_changed = true;
+  _info = info_sleep;
   _info_color = _blue;
   _info_text = "SLEEP";
   _sleep_state_active = true;
@@ -38,6 +38,9 @@ void Traffic_light::set_info_sleep() {
   _start_state_active = false;
 }
 
+Traffic_light::info Traffic_light::get_info() { //
+  return _info;
+}
 String Traffic_light::get_info_color() { //
   return _info_color;
 }
@@ -55,13 +58,3 @@ bool Traffic_light::is_in_user_do_stuff_state() {
 bool Traffic_light::is_in_start_state() { //
   return _start_state_active;
 }
-
-bool Traffic_light::info_has_changed() {
-  if (_info_has_changed) {
-    _info_has_changed = false;
-    return true;
-  }
-  return false;
-}
-
-void Traffic_light::set_info_has_changed() { _info_has_changed = true; }
\ No newline at end of file
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Flash and RAM size report for the firmware ELF (avr-nm / avr-size).
+
+Ranks the symbols by size and sums them up per library. Exits with 1 if a
+configured budget is exceeded, which fails the build when this tool runs as
+a post action of PlatformIO (see tools/size_report_extra.py).
+
+USAGE:
+    size_report.py firmware.elf [--nm avr-nm] [--size avr-size] [--top 25]
+                   [--budget flash=240000] [--budget ram=6144]
+                   [--budget ArduinoSTL.flash=20000] [--budget SD.ram=800]
+
+A symbol gets assigned to a library by its source path (needs debug info in
+the ELF) or otherwise by its name, see LIBRARIES.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+# Library name, source path pattern, symbol name pattern
+LIBRARIES = [
+    ("ArduinoSTL", r"ArduinoSTL", r"^(std::|__cxa|__gxx|operator new|operator delete)"),
+    ("Nextion", r"Nextion", r"^Nex"),
+    ("SD", r"[/\\]SD[/\\]|SdFat|utility[/\\]Sd", r"^(Sd|SD|File::|SDLib::|card|volume|root)"),
+    ("Cylinder", r"cylinder-library", r"^Cylinder::"),
+    ("Debounce", r"debounce-library", r"^Debounce::"),
+    ("EEPROM_Counter", r"eeprom-counter-library", r"^EEPROM_Counter::"),
+    ("Insomnia", r"insomnia-delay-library", r"^Insomnia::"),
+    ("CONTROLLINO", r"CONTROLLINO", r"^Controllino"),
+    ("Arduino core", r"framework-arduino|cores[/\\]arduino",
+     r"^(HardwareSerial|Serial\d?|Print::|Stream::|String::|operator\+\(|__vector_|"
+     r"analogRead|digitalWrite|digitalRead|pinMode|micros|millis|delay|init|timer0_|"
+     r"serialEvent|_GLOBAL__)"),
+    ("avr-libc", r"avr-libc|libc[/\\]|libm[/\\]|libgcc",
+     r"^(__|_?mem|str|vf?s?n?printf|vf?s?scanf|malloc|free|realloc|calloc|atoi|atol|"
+     r"ltoa|ultoa|itoa|utoa|dtostr|fdev|fputc|fgetc|abort|exit)"),
+    ("src", r"[/\\]src[/\\]", None),
+]
+OTHER = "other"
+
+FLASH_TYPES = set("TtWwAa")
+RAM_TYPES = set("DdBbRrVvGgSs")
+AVR_RAM_OFFSET = 0x800000  # data addresses of avr ELF files
+
+
+def run(command):
+    return subprocess.run(command, check=True, stdout=subprocess.PIPE,
+                          universal_newlines=True).stdout
+
+
+def read_sections(size_tool, elf):
+    """Returns {section: size} from 'size -A'."""
+    sections = {}
+    for line in run([size_tool, "-A", elf]).splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith(".") and fields[1].isdigit():
+            sections[fields[0]] = int(fields[1])
+    return sections
+
+
+def read_symbols(nm_tool, elf):
+    """Returns a list of (size, type, name, source path) from 'nm -S -C -l'."""
+    symbols = []
+    output = run([nm_tool, "--size-sort", "-S", "-C", "-l", elf])
+    for line in output.splitlines():
+        match = re.match(r"^([0-9a-fA-F]+) ([0-9a-fA-F]+) (\w) (.*)$", line)
+        if not match:
+            continue
+        address, size, symbol_type, rest = match.groups()
+        name, _, source = rest.partition("\t")
+        symbols.append((int(address, 16), int(size, 16), symbol_type, name, source))
+    return symbols
+
+
+def get_library(name, source):
+    name = re.sub(r"^(vtable|typeinfo name|typeinfo|VTT|guard variable) for ", "", name)
+    for library, path_pattern, name_pattern in LIBRARIES:
+        if source and path_pattern and re.search(path_pattern, source):
+            return library
+    for library, path_pattern, name_pattern in LIBRARIES:
+        if name_pattern and re.search(name_pattern, name):
+            return library
+    return "src" if source else OTHER
+
+
+def classify(symbols):
+    """Returns a list of (library, flash bytes, ram bytes, name)."""
+    result = []
+    for address, size, symbol_type, name, source in symbols:
+        is_ram = symbol_type in RAM_TYPES or address >= AVR_RAM_OFFSET
+        is_initialized = symbol_type in "DdRrGgVv"
+        flash = size if (not is_ram or is_initialized) else 0  # initial values live in flash
+        ram = size if is_ram else 0
+        if symbol_type not in FLASH_TYPES | RAM_TYPES:
+            continue
+        result.append((get_library(name, source), flash, ram, name))
+    return result
+
+
+def parse_budgets(budget_arguments):
+    budgets = {}
+    for argument in budget_arguments or []:
+        key, _, value = argument.partition("=")
+        if not value.strip().isdigit():
+            sys.exit("invalid budget: %s (expected name=bytes)" % argument)
+        budgets[key.strip()] = int(value)
+    return budgets
+
+
+def print_table(title, header, rows):
+    print()
+    print(title)
+    print("-" * len(title))
+    print(header)
+    for row in rows:
+        print(row)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="avr-nm")
+    parser.add_argument("--size", default="avr-size")
+    parser.add_argument("--top", type=int, default=25, help="number of symbols to list")
+    parser.add_argument("--budget", action="append",
+                        help="flash=N, ram=N or <library>.flash=N, <library>.ram=N")
+    parser.add_argument("--quiet", action="store_true", help="only print the budget check")
+    args = parser.parse_args()
+
+    sections = read_sections(args.size, args.elf)
+    symbols = classify(read_symbols(args.nm, args.elf))
+    budgets = parse_budgets(args.budget)
+
+    text = sections.get(".text", 0)
+    data = sections.get(".data", 0)
+    bss = sections.get(".bss", 0) + sections.get(".noinit", 0)
+    totals = {"flash": text + data, "ram": data + bss}
+
+    libraries = defaultdict(lambda: [0, 0])
+    for library, flash, ram, name in symbols:
+        libraries[library][0] += flash
+        libraries[library][1] += ram
+
+    if not args.quiet:
+        print("SIZE REPORT %s" % args.elf)
+        print(".text %d  .data %d  .bss %d  ->  flash %d  static ram %d"
+              % (text, data, bss, totals["flash"], totals["ram"]))
+
+        ranked = sorted(libraries.items(), key=lambda item: -item[1][0])
+        print_table("BY LIBRARY", "%8s %8s  %s" % ("flash", "ram", "library"),
+                    ["%8d %8d  %s" % (flash, ram, library)
+                     for library, (flash, ram) in ranked])
+
+        for column, title in ((1, "TOP FLASH SYMBOLS"), (2, "TOP RAM SYMBOLS (.data + .bss)")):
+            ranked = sorted((s for s in symbols if s[column]), key=lambda s: -s[column])
+            print_table(title, "%8s  %-16s %s" % ("bytes", "library", "symbol"),
+                        ["%8d  %-16s %s" % (s[column], s[0], s[3][:90])
+                         for s in ranked[:args.top]])
+
+    exceeded = False
+    if budgets:
+        rows = []
+        for key, budget in sorted(budgets.items()):
+            library, _, memory = key.rpartition(".")
+            if memory not in ("flash", "ram"):
+                sys.exit("invalid budget: %s (use flash or ram)" % key)
+            if library:
+                used = libraries[library][0 if memory == "flash" else 1]
+            else:
+                used = totals[memory]
+            state = "OK" if used <= budget else "EXCEEDED"
+            exceeded = exceeded or used > budget
+            rows.append("%8d %8d  %-9s %s" % (used, budget, state, key))
+        print_table("BUDGETS", "%8s %8s  %-9s %s" % ("used", "budget", "state", "item"), rows)
+
+    if exceeded:
+        print("\nsize budget exceeded")
+    return 1 if exceeded else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,47 @@
+"""
+PlatformIO extra script: size report and size budgets of the firmware.
+
+After every link tools/size_report.py checks the budgets of platformio.ini and
+fails the build if one is exceeded:
+
+    custom_size_budgets =
+      flash=240000
+      ram=6144
+      ArduinoSTL.flash=20000
+
+The complete ranked report by symbol and by library:
+
+    pio run -e controllino_mega -t size_report
+"""
+
+import os
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+SIZE_REPORT = os.path.join("$PROJECT_DIR", "tools", "size_report.py")
+
+
+def get_tool(name):
+    # avr-gcc -> avr-nm, avr-size
+    return env.subst("$CC").replace("gcc", name)
+
+
+def get_budget_arguments():
+    budgets = env.GetProjectOption("custom_size_budgets", "")
+    return " ".join("--budget " + line.strip() for line in budgets.splitlines() if line.strip())
+
+
+def get_command(options):
+    return '"$PYTHONEXE" "%s" "$BUILD_DIR/${PROGNAME}.elf" --nm "%s" --size "%s" %s %s' % (
+        SIZE_REPORT, get_tool("nm"), get_tool("size"), get_budget_arguments(), options)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", env.VerboseAction(
+    get_command("--quiet"), "Checking size budgets"))
+
+env.AddCustomTarget(
+    name="size_report",
+    dependencies="$BUILD_DIR/${PROGNAME}.elf",
+    actions=get_command("--top 30"),
+    title="Size Report",
+    description="Flash and RAM usage by symbol and by library")
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+Decoder for the binary telemetry stream of the rig (src/telemetry.h).
+
+Reads the COBS encoded frames from the USB serial port (or a recorded file)
+and prints them as CSV or as a live terminal dashboard.
+
+USAGE:
+    telemetry_decoder.py --port /dev/ttyUSB0 --csv > rig.csv
+    telemetry_decoder.py --port /dev/ttyUSB0 --dashboard --channels step,force
+    telemetry_decoder.py --file recorded.bin --csv
+
+Requires pyserial for --port (pip install pyserial).
+
+Opening the port resets the Mega, --channels is sent once the first frame
+arrives and again while frames of channels that are not selected keep coming.
+
+A force frame takes 10 bytes on the line, 1 kHz force samples use about 87 %
+of 115200 baud. Select force together with few other channels, frames that do
+not fit get dropped by the rig (dropped_frames of loop_timing).
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+CHANNELS = ["step", "force", "loop_timing", "counter", "outputs", "memory"]
+
+# Bit order of get_output_states() in src/main.cpp
+OUTPUTS = [
+    "sledge_inlet", "sledge_vent", "blade", "frontclap", "motor_upper_enable",
+    "motor_lower_enable", "motor_upper_pulse", "motor_lower_pulse", "green_light", "red_light"
+]
+
+# Order of enum counter in src/main.cpp
+COUNTERS = ["longtime_counter", "shorttime_counter", "upper_strap_feed", "lower_strap_feed"]
+
+SELECT_COMMAND = b"C"
+SELECT_RETRY_SECONDS = 1.0
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(encoded):
+    decoded = bytearray()
+    i = 0
+    while i < len(encoded):
+        code = encoded[i]
+        if code == 0 or i + code > len(encoded):
+            return None
+        decoded += encoded[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(encoded):
+            decoded.append(0)
+    return bytes(decoded)
+
+
+def decode_payload(channel, payload):
+    """Returns a list of (field name, value) pairs."""
+    if channel == "step":
+        mode, step = payload[0], payload[1]
+        text = payload[2:].decode("ascii", "replace")
+        return [("mode", "continuous" if mode else "main"), ("step", step + 1), ("text", text)]
+    if channel == "force":
+        return [("force_N", struct.unpack("<h", payload)[0])]
+    if channel == "loop_timing":
+        average, maximum, loops, dropped = struct.unpack("<IIIH", payload)
+        return [("average_us", average), ("max_us", maximum), ("loops", loops),
+                ("dropped_frames", dropped)]
+    if channel == "counter":
+        number, value = struct.unpack("<Bi", payload)
+        name = COUNTERS[number] if number < len(COUNTERS) else str(number)
+        return [("counter", name), ("value", value)]
+    if channel == "outputs":
+        states = struct.unpack("<H", payload)[0]
+        return [(name, (states >> bit) & 1) for bit, name in enumerate(OUTPUTS)]
+    if channel == "memory":
+        names = ["free_ram", "min_stack_headroom", "heap_free", "largest_free_block", "heap_end",
+                 "pool_exhaustions"]
+        return list(zip(names, struct.unpack("<HHHHHH", payload)))
+    return []
+
+
+def decode_frame(encoded):
+    """Returns (timestamp_us, channel, fields) or None for a corrupt frame."""
+    frame = cobs_decode(encoded)
+    if frame is None or len(frame) < 6 or crc8(frame[:-1]) != frame[-1]:
+        return None
+    number = frame[0]
+    if number >= len(CHANNELS):
+        return None
+    timestamp = struct.unpack("<I", frame[1:5])[0]
+    channel = CHANNELS[number]
+    try:
+        return timestamp, channel, decode_payload(channel, frame[5:-1])
+    except (struct.error, IndexError):
+        return None
+
+
+def read_frames(read_bytes):
+    """Splits the stream at the zero delimiters, yields decoded frames."""
+    buffer = bytearray()
+    while True:
+        data = read_bytes()
+        if data is None:
+            return
+        for byte in data:
+            if byte == 0:
+                if buffer:
+                    yield decode_frame(bytes(buffer))
+                buffer.clear()
+            else:
+                buffer.append(byte)
+
+
+def select_channels(port, mask, frames):
+    """Passes the frames through and sends the channel selection to the rig.
+
+    A selection sent while the bootloader runs (the port has just been opened)
+    gets lost: wait for the first frame, then resend as long as frames of
+    channels outside of the mask arrive.
+    """
+    last_sent = None
+    for frame in frames:
+        if frame is not None:
+            channel_bit = 1 << CHANNELS.index(frame[1])
+            not_selected = not channel_bit & mask
+            retry_is_due = last_sent is None or time.time() - last_sent > SELECT_RETRY_SECONDS
+            if (last_sent is None or not_selected) and retry_is_due:
+                port.write(SELECT_COMMAND + bytes([mask]))
+                last_sent = time.time()
+        yield frame
+
+
+def print_csv(frames):
+    print("time_us,channel,fields")
+    for frame in frames:
+        if frame is None:
+            continue
+        timestamp, channel, fields = frame
+        values = ",".join("%s=%s" % field for field in fields)
+        print("%d,%s,%s" % (timestamp, channel, values), flush=True)
+
+
+def print_dashboard(frames):
+    latest = {}
+    force_times = []
+    corrupt = 0
+    last_draw = 0
+    for frame in frames:
+        if frame is None:
+            corrupt += 1
+            continue
+        timestamp, channel, fields = frame
+        if channel == "counter":
+            latest[fields[0][1]] = [("value", fields[1][1])]
+        else:
+            latest[channel] = fields
+        if channel == "force":
+            force_times = [t for t in force_times if timestamp - t < 1000000] + [timestamp]
+
+        if time.time() - last_draw < 0.2:
+            continue
+        last_draw = time.time()
+        lines = ["\033[H\033[J" + "RIG TELEMETRY  (corrupt frames: %d)" % corrupt]
+        for name in sorted(latest):
+            values = "  ".join("%s=%s" % field for field in latest[name])
+            lines.append("%-18s %s" % (name, values))
+        lines.append("%-18s %d Hz" % ("force_rate", len(force_times)))
+        print("\n".join(lines), flush=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port of the controllino, e.g. /dev/ttyUSB0")
+    source.add_argument("--file", help="recorded binary stream, '-' for stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--channels", help="comma separated channels to select on the rig: "
+                        + ",".join(CHANNELS))
+    output = parser.add_mutually_exclusive_group()
+    output.add_argument("--csv", action="store_true", help="print one CSV line per frame")
+    output.add_argument("--dashboard", action="store_true", help="show the latest values")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial
+        port = serial.Serial(args.port, args.baud, timeout=0.1)
+        frames = read_frames(lambda: port.read(256))
+        if args.channels:
+            mask = 0
+            for name in args.channels.split(","):
+                mask |= 1 << CHANNELS.index(name.strip())
+            frames = select_channels(port, mask, frames)
+    else:
+        stream = sys.stdin.buffer if args.file == "-" else open(args.file, "rb")
+        frames = read_frames(lambda: stream.read(256) or None)
+
+    try:
+        if args.dashboard:
+            print_dashboard(frames)
+        else:
+            print_csv(frames)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()